@@ -1,4 +1,5 @@
 //cl /EHsc /Zi /std:c++20 x87test.cpp x87testasm.obj
+//cl /EHsc /Zi /std:c++20 /arch:AVX2 /fp:precise x87test.cpp x87testasm.obj   (FMA-enabled; batch results must still match scalar)
 
 #include <stdio.h>
 #include <stdint.h>
@@ -15,6 +16,8 @@
 
 #include "../x87fp64trans.cpp"
 #include "../x87fp80.cpp"
+#include "../x87fp80batch.cpp"
+#include "../x87fp80array.h"
 #include "../x87fpext.h"
 #undef print_val
 
@@ -38,12 +41,17 @@ extern "C"
     uint16_t fild6480(int64_t const *src, fp80_t *dst);
     uint16_t fild3280(int32_t const *src, fp80_t *dst);
     uint16_t fild1680(int16_t const *src, fp80_t *dst);
+    uint16_t fild6464(int64_t const *src, fp64_t *dst);
+    uint16_t fild3264(int32_t const *src, fp64_t *dst);
+    uint16_t fild1664(int16_t const *src, fp64_t *dst);
     uint16_t fst8080(fp80_t const *src, fp80_t *dst);
     uint16_t fst8064(fp80_t const *src, fp64_t *dst);
     uint16_t fst8032(fp80_t const *src, float *dst);
     uint16_t fist8064(fp80_t const *src, int64_t *dst);
     uint16_t fist8032(fp80_t const *src, int32_t *dst);
     uint16_t fist8016(fp80_t const *src, int16_t *dst);
+    uint16_t fxam80(fp80_t const *src);
+    uint16_t fxam64(fp64_t const *src);
     uint16_t fadd80(fp80_t *src1, fp80_t *src2, fp80_t *dst);
     uint16_t fsub80(fp80_t *src1, fp80_t *src2, fp80_t *dst);
     uint16_t fmul80(fp80_t *src1, fp80_t *src2, fp80_t *dst);
@@ -157,6 +165,7 @@ struct errors_t
     uint32_t experrors = 0;
     uint32_t infinities = 0;
     uint32_t swerrors = 0;
+    uint32_t batcherrors = 0;
     std::array<uint32_t, 64> errors = {{ 0 }};
     char const *name = nullptr;
     int print_thresh;
@@ -317,6 +326,25 @@ struct errors_t
         }
     }
 
+    //
+    // check that a batch result matches the scalar result exactly
+    //
+    template<typename PrintFuncType>
+    void check_batch(fp64_t const &batchdst, fp64_t const &scalardst, PrintFuncType printname)
+    {
+        if (batchdst.as_fpbits64() != scalardst.as_fpbits64())
+        {
+            batcherrors++;
+            if (printed++ < MAX_PRINT_ERRORS)
+            {
+                printname();
+                ::print(" = {:016X} [{:+.12e}] (scalar gives {:016X} [{:+.12e}])\n",
+                    batchdst.as_fpbits64(), batchdst.as_double(),
+                    scalardst.as_fpbits64(), scalardst.as_double());
+            }
+        }
+    }
+
     //
     // print a summary report
     //
@@ -335,6 +363,8 @@ struct errors_t
             eprint("   {:9} pseudo infinities [{:.2f}%]\n", infinities, double(infinities) * 100.0 / double(count));
         if (swerrors != 0)
             eprint("   {:9} status word errors [{:.2f}%]\n", swerrors, double(swerrors) * 100.0 / double(count));
+        if (batcherrors != 0)
+            eprint("   {:9} batch/scalar mismatches [{:.2f}%]\n", batcherrors, double(batcherrors) * 100.0 / double(count));
         eprint("\n");
     }
 };
@@ -662,6 +692,62 @@ void print_val(char const *name, fpext96_t const &val)
     print("{} = {:c}{:016X}`{:08X}e{:+05d} ({:+.12e})\n", name, val.sign() ? '-' : '+', val.mantissa(), val.extend(), val.exponent(), val.as_double());
 }
 
+void print_val(char const *name, fpext128_t const &val)
+{
+    print("{} = {:c}{:016X}`{:016X}e{:+05d} ({:+.12e})\n", name, val.sign() ? '-' : '+', val.mantissa(), val.extend(), val.exponent(), val.as_double());
+}
+
+void print_val(char const *name, fpext106_t const &val)
+{
+    print("{} = {:c}{:016X}`{:08X}e{:+05d} ({:+.12e})\n", name, val.sign() ? '-' : '+', val.mantissa(), val.extend(), val.exponent(), val.as_double());
+}
+
+//
+// compile-time checks of the constexpr table generation
+//
+static_assert(fpext96_t::from_string("0.5") == fpext96_t(0x8000000000000000ull, 0x00000000, -1, 0));
+static_assert(exp2m1_table<fpext96_t, 16>()[0] == fpext96_t(0x8000000000000000ull, 0x00000000, -1, 1));
+static_assert(exp2m1_table<fpext96_t, 16>()[24] == fpext96_t(0xd413cccfe7799211ull, 0x65f626ce, -2, 0));
+static_assert(exp2m1_table<fpext96_t, 16>()[32] == fpext96_t(0x8000000000000000ull, 0x00000000, 0, 0));
+static_assert(fpext_table_t(exp2m1_table<fpext96_t, 16>())[24] == exp2m1_table<fpext96_t, 16>()[24]);
+static_assert(fpext_table_t(exp2m1_table<fpext64_t, 16>())[0] == fpext64_t(-0.5));
+static_assert(fpext_table_t(exp2m1_table<fpext64_t, 16>())[16].exponent() == fpext64_t::EXPONENT_MIN);
+
+//
+// fma rounds once, so it recovers the low bits of a product that a
+// separate multiply rounds away
+//
+static_assert(fpext64_t::fma(fpext64_t(1.0 + 0x1p-40), fpext64_t(1.0 + 0x1p-40), fpext64_t(-(1.0 + 0x1p-39))) == fpext64_t(0x1p-80));
+static_assert(fpext96_t::fma(fpext96_t(1.0 + 0x1p-50), fpext96_t(1.0 + 0x1p-50), fpext96_t(-(1.0 + 0x1p-49))) == fpext96_t(0x1p-100));
+
+//
+// add and sub select their operand order and result without branching,
+// including cancellation down into the extension bits
+//
+static_assert(fpext64_t(-3.0) + fpext64_t(5.0) == fpext64_t(2.0));
+static_assert(fpext64_t(0.75) - fpext64_t(0x1p40) == fpext64_t(0.75 - 0x1p40));
+static_assert(fpext96_t(1.0) + fpext96_t(0x1p-70) - fpext96_t(1.0) == fpext96_t(0x1p-70));
+
+//
+// the fpext80_t multiply keeps the cross products with the 16-bit extension
+//
+static_assert((fpext80_t(1.0) + fpext80_t(0x1p-70)) * fpext80_t(3.0) - fpext80_t(3.0) == fpext80_t(0x3p-70));
+static_assert(fpext80_t(1.0 + 0x1p-35) * fpext80_t(1.0 + 0x1p-35) - fpext80_t(1.0 + 0x1p-34) == fpext80_t(0x1p-70));
+
+//
+// the f2xm1 Taylor term counts for each table size
+//
+static_assert(f2xm1_tables<4>::TAYLOR_TERMS == 9);
+static_assert(f2xm1_tables<6>::TAYLOR_TERMS == 7);
+static_assert(f2xm1_tables<8>::TAYLOR_TERMS == 6);
+
+//
+// fpext106_t truncates to fp64 like the other extended types
+//
+static_assert(fpext106_t(1.0, -0x1p-60).as_double() == 1.0 - 0x1p-53);
+static_assert(fpext106_t(-1.5, 0x1p-60).as_double() == -(1.5 - 0x1p-52));
+static_assert(fpext106_t(1.5, 0x1p-60).as_double() == 1.5);
+
 //
 // validate conversions between different types
 //
@@ -695,6 +781,22 @@ void validate_conversions()
                     src.as_fpbits64(),
                     temp112.sign(), temp112.exponent(), temp112.mantissa(), temp112.extend(),
                     src112.as_fpbits64());
+
+            fpext128_t temp128(src);
+            auto src128 = temp128.as_fp64();
+            if (src.as_fpbits64() != src128.as_fpbits64())
+                print("64-bit: {:016X} -> {}.{}:{:016X}{:016X} -> {:016X}\n",
+                    src.as_fpbits64(),
+                    temp128.sign(), temp128.exponent(), temp128.mantissa(), temp128.extend(),
+                    src128.as_fpbits64());
+
+            fpext106_t temp106(src);
+            auto src106 = temp106.as_fp64();
+            if (src.as_fpbits64() != src106.as_fpbits64())
+                print("64-bit: {:016X} -> {:+.17e}{:+.17e} -> {:016X}\n",
+                    src.as_fpbits64(),
+                    temp106.hi(), temp106.lo(),
+                    src106.as_fpbits64());
         }
     }
 
@@ -726,6 +828,27 @@ void validate_conversions()
                     src.sign_exp(), src.mantissa(),
                     temp112.sign(), temp112.exponent(), temp112.mantissa(), temp112.extend(),
                     src112.sign_exp(), src112.mantissa());
+
+            fpext128_t temp128(src);
+            auto src128 = temp128.as_fp80();
+            if (src.sign_exp() != src128.sign_exp() || src.mantissa() != src128.mantissa())
+                print("80-bit: {:04X}:{:016X} -> {}.{}:{:016X}{:016X} -> {:04X}:{:016X}\n",
+                    src.sign_exp(), src.mantissa(),
+                    temp128.sign(), temp128.exponent(), temp128.mantissa(), temp128.extend(),
+                    src128.sign_exp(), src128.mantissa());
+
+            // fpext106_t only has the exponent range of a double, and needs
+            // another 64 bits of headroom to hold the low part
+            if (src.exponent() > 64 - FP64_EXPONENT_BIAS && src.exponent() <= FP64_EXPONENT_BIAS)
+            {
+                fpext106_t temp106(src);
+                auto src106 = temp106.as_fp80();
+                if (src.sign_exp() != src106.sign_exp() || src.mantissa() != src106.mantissa())
+                    print("80-bit: {:04X}:{:016X} -> {:+.17e}{:+.17e} -> {:04X}:{:016X}\n",
+                        src.sign_exp(), src.mantissa(),
+                        temp106.hi(), temp106.lo(),
+                        src106.sign_exp(), src106.mantissa());
+            }
         }
     }
 
@@ -854,6 +977,108 @@ void test_unary64_2(FpFuncType fpfunc, X87FuncType x87func, char const *name, in
     errs.print_report(name);
 }
 
+//
+// test a batch unary 64-bit operation; values are processed in groups of 4
+// so that the accumulated status word can be compared against the real FPU
+//
+template<typename FpFuncType, typename X87FuncType>
+void test_unary64_batch(FpFuncType fpfunc, X87FuncType x87func, char const *name, int print_thresh)
+{
+    errors_t errs(name, print_thresh);
+    std::vector<fp64_t> ourdst(values64.size());
+    for (int isrc1 = 0; isrc1 < values64.size(); isrc1 += 4)
+    {
+        int count = std::min<int>(4, int(values64.size()) - isrc1);
+        auto oursw = fpfunc(&values64[isrc1], &ourdst[isrc1], count) & ~X87SW_TOP_MASK;
+
+        fp64_t x87dst[4];
+        uint16_t x87sw = 0;
+        for (int index = 0; index < count; index++)
+        {
+            fp64_t src1(values64[isrc1 + index]);
+            x87sw |= x87func(&src1, &x87dst[index]) & ~X87SW_TOP_MASK;
+        }
+
+        for (int index = 0; index < count; index++)
+        {
+            fp64_t const &src1 = values64[isrc1 + index];
+            errs.check_value(ourdst[isrc1 + index], x87dst[index], oursw, x87sw,
+                [&]() { print("{}({:016X} [{:+.12e}])", name, src1.as_fpbits64(), src1.as_double()); },
+                [&]() { fp64_t res; fpfunc(&src1, &res, 1); });
+
+            // a single element always takes the scalar path
+            fp64_t scalardst;
+            fpfunc(&src1, &scalardst, 1);
+            errs.check_batch(ourdst[isrc1 + index], scalardst,
+                [&]() { print("{}({:016X} [{:+.12e}])", name, src1.as_fpbits64(), src1.as_double()); });
+        }
+    }
+    LARGE_INTEGER start, end;
+    QueryPerformanceCounter(&start);
+    size_t reps = 0;
+    do
+    {
+        fpfunc(&values64[0], &ourdst[0], int(values64.size()));
+        reps += values64.size();
+        QueryPerformanceCounter(&end);
+    } while (end.QuadPart - start.QuadPart < min_timing_ticks);
+    eprint("{}: ticks = {:.2f}\n", name, double(end.QuadPart - start.QuadPart) / double(reps));
+    errs.print_report(name);
+}
+
+//
+// test a batch unary 64-bit operation with two results
+//
+template<typename FpFuncType, typename X87FuncType>
+void test_unary64_2_batch(FpFuncType fpfunc, X87FuncType x87func, char const *name, int print_thresh)
+{
+    errors_t errs(name, print_thresh);
+    std::vector<fp64_t> ourdst1(values64.size()), ourdst2(values64.size());
+    for (int isrc1 = 0; isrc1 < values64.size(); isrc1 += 4)
+    {
+        int count = std::min<int>(4, int(values64.size()) - isrc1);
+        auto oursw = fpfunc(&values64[isrc1], &ourdst1[isrc1], &ourdst2[isrc1], count) & ~X87SW_TOP_MASK;
+
+        fp64_t x87dst1[4], x87dst2[4];
+        uint16_t x87sw = 0;
+        for (int index = 0; index < count; index++)
+        {
+            fp64_t src1(values64[isrc1 + index]);
+            x87sw |= x87func(&src1, &x87dst1[index], &x87dst2[index]) & ~X87SW_TOP_MASK;
+        }
+
+        for (int index = 0; index < count; index++)
+        {
+            fp64_t const &src1 = values64[isrc1 + index];
+            errs.check_value(ourdst1[isrc1 + index], x87dst1[index], oursw, x87sw,
+                [&]() { print("{}({:016X} [{:+.12e}])[1]", name, src1.as_fpbits64(), src1.as_double()); },
+                [&]() { fp64_t res1, res2; fpfunc(&src1, &res1, &res2, 1); });
+            errs.check_value(ourdst2[isrc1 + index], x87dst2[index], oursw, oursw,
+                [&]() { print("{}({:016X} [{:+.12e}])[2]", name, src1.as_fpbits64(), src1.as_double()); },
+                [&]() { fp64_t res1, res2; fpfunc(&src1, &res1, &res2, 1); }, true);
+
+            // a single element always takes the scalar path
+            fp64_t scalardst1, scalardst2;
+            fpfunc(&src1, &scalardst1, &scalardst2, 1);
+            errs.check_batch(ourdst1[isrc1 + index], scalardst1,
+                [&]() { print("{}({:016X} [{:+.12e}])[1]", name, src1.as_fpbits64(), src1.as_double()); });
+            errs.check_batch(ourdst2[isrc1 + index], scalardst2,
+                [&]() { print("{}({:016X} [{:+.12e}])[2]", name, src1.as_fpbits64(), src1.as_double()); });
+        }
+    }
+    LARGE_INTEGER start, end;
+    QueryPerformanceCounter(&start);
+    size_t reps = 0;
+    do
+    {
+        fpfunc(&values64[0], &ourdst1[0], &ourdst2[0], int(values64.size()));
+        reps += values64.size();
+        QueryPerformanceCounter(&end);
+    } while (end.QuadPart - start.QuadPart < min_timing_ticks);
+    eprint("{}: ticks = {:.2f}\n", name, double(end.QuadPart - start.QuadPart) / double(reps));
+    errs.print_report(name);
+}
+
 //
 // test a binary 64-bit operation
 //
@@ -902,6 +1127,66 @@ void test_binary64(FpFuncType fpfunc, X87FuncType x87func, char const *name, int
     errs.print_report(name);
 }
 
+//
+// test a batch binary 64-bit operation; values are processed in groups of 4
+// so that the accumulated status word can be compared against the real FPU
+//
+template<typename FpFuncType, typename X87FuncType>
+void test_binary64_batch(FpFuncType fpfunc, X87FuncType x87func, char const *name, int print_thresh)
+{
+    errors_t errs(name, print_thresh);
+    std::vector<fp64_t> row1, row2;
+    for (int isrc2 = 0; isrc2 < values64.size(); isrc2 += 5)
+        row2.push_back(values64[isrc2]);
+    std::vector<fp64_t> ourdst(row2.size());
+    for (int isrc1 = 0; isrc1 < values64.size(); isrc1 += 5)
+    {
+        row1.assign(row2.size(), values64[isrc1]);
+        for (int isrc2 = 0; isrc2 < row2.size(); isrc2 += 4)
+        {
+            int count = std::min<int>(4, int(row2.size()) - isrc2);
+            auto oursw = fpfunc(&row2[isrc2], &row1[isrc2], &ourdst[isrc2], count) & ~X87SW_TOP_MASK;
+
+            fp64_t x87dst[4];
+            uint16_t x87sw = 0;
+            for (int index = 0; index < count; index++)
+            {
+                fp64_t src1(row1[isrc2 + index]);
+                fp64_t src2(row2[isrc2 + index]);
+                x87sw |= x87func(&src2, &src1, &x87dst[index]) & ~X87SW_TOP_MASK;
+            }
+
+            for (int index = 0; index < count; index++)
+            {
+                fp64_t const &src1 = row1[isrc2 + index];
+                fp64_t const &src2 = row2[isrc2 + index];
+                errs.check_value(ourdst[isrc2 + index], x87dst[index], oursw, x87sw,
+                    [&]() { print("{}({:016X} [{:+.12e}], {:016X} [{:+.12e}])", name, src2.as_fpbits64(), src2.as_double(), src1.as_fpbits64(), src1.as_double()); },
+                    [&]() { fp64_t res; fpfunc(&src2, &src1, &res, 1); });
+
+                // a single element always takes the scalar path
+                fp64_t scalardst;
+                fpfunc(&src2, &src1, &scalardst, 1);
+                errs.check_batch(ourdst[isrc2 + index], scalardst,
+                    [&]() { print("{}({:016X} [{:+.12e}], {:016X} [{:+.12e}])", name, src2.as_fpbits64(), src2.as_double(), src1.as_fpbits64(), src1.as_double()); });
+            }
+        }
+    }
+    LARGE_INTEGER start, end;
+    QueryPerformanceCounter(&start);
+    size_t reps = 0;
+    row1.assign(values64.rbegin(), values64.rend());
+    ourdst.resize(values64.size());
+    do
+    {
+        fpfunc(&values64[0], &row1[0], &ourdst[0], int(values64.size()));
+        reps += values64.size();
+        QueryPerformanceCounter(&end);
+    } while (end.QuadPart - start.QuadPart < min_timing_ticks);
+    eprint("{}: ticks = {:.2f}\n", name, double(end.QuadPart - start.QuadPart) / double(reps));
+    errs.print_report(name);
+}
+
 //
 // test a unary 80-bit operation
 //
@@ -962,6 +1247,46 @@ void test_load(FpFuncType fpfunc, X87FuncType x87func, std::vector<SrcType> cons
     errs.print_report(name);
 }
 
+//
+// test a batch load operation; values are converted in groups of 4 so that
+// the accumulated status word can be compared against the real FPU
+//
+template<typename DstType, typename FpFuncType, typename X87FuncType, typename SrcType>
+void test_load_batch(FpFuncType fpfunc, X87FuncType x87func, std::vector<SrcType> const &vals, char const *name, int print_thresh = 0)
+{
+    errors_t errs(name, print_thresh);
+    std::vector<DstType> ourdst(vals.size());
+    for (int isrc1 = 0; isrc1 < vals.size(); isrc1 += 4)
+    {
+        int count = std::min<int>(4, int(vals.size()) - isrc1);
+        auto oursw = fpfunc(&vals[isrc1], &ourdst[isrc1], count);
+
+        DstType x87dst[4];
+        uint16_t x87sw = 0;
+        for (int index = 0; index < count; index++)
+            x87sw |= x87func(&vals[isrc1 + index], &x87dst[index]);
+
+        for (int index = 0; index < count; index++)
+        {
+            int isrc = isrc1 + index;
+            errs.check_value(ourdst[isrc], x87dst[index], oursw, x87sw,
+                [&]() { print("{}(", name); for (uint32_t index = 0; index < sizeof(vals[isrc]); index++) print("{:02X}", ((uint8_t const *)&vals[isrc])[sizeof(vals[isrc]) - 1 - index]); print(")"); },
+                [&]() { DstType res; fpfunc(&vals[isrc], &res, 1); });
+        }
+    }
+    LARGE_INTEGER start, end;
+    QueryPerformanceCounter(&start);
+    size_t reps = 0;
+    do
+    {
+        fpfunc(&vals[0], &ourdst[0], int(vals.size()));
+        reps += vals.size();
+        QueryPerformanceCounter(&end);
+    } while (end.QuadPart - start.QuadPart < min_timing_ticks);
+    eprint("{}: ticks = {:.2f}\n", name, double(end.QuadPart - start.QuadPart) / double(reps));
+    errs.print_report(name);
+}
+
 //
 // test a store operation
 //
@@ -984,6 +1309,46 @@ void test_store(FpFuncType fpfunc, X87FuncType x87func, std::vector<SrcType> con
     errs.print_report(name);
 }
 
+//
+// test a batch store operation; values are converted in groups of 4 so that
+// the accumulated status word can be compared against the real FPU
+//
+template<typename DstType, typename FpFuncType, typename X87FuncType, typename SrcType>
+void test_store_batch(FpFuncType fpfunc, X87FuncType x87func, std::vector<SrcType> const &vals, char const *name, int print_thresh = 0)
+{
+    errors_t errs(name, print_thresh);
+    std::vector<DstType> ourdst(vals.size());
+    for (int isrc1 = 0; isrc1 < vals.size(); isrc1 += 4)
+    {
+        int count = std::min<int>(4, int(vals.size()) - isrc1);
+        auto oursw = fpfunc(&vals[isrc1], &ourdst[isrc1], count);
+
+        DstType x87dst[4];
+        uint16_t x87sw = 0;
+        for (int index = 0; index < count; index++)
+            x87sw |= x87func(&vals[isrc1 + index], &x87dst[index]);
+
+        for (int index = 0; index < count; index++)
+        {
+            int isrc = isrc1 + index;
+            errs.check_value(ourdst[isrc], x87dst[index], oursw, x87sw,
+                [&]() { print("{}({})", name, vals[isrc]); },
+                [&]() { DstType res; fpfunc(&vals[isrc], &res, 1); });
+        }
+    }
+    LARGE_INTEGER start, end;
+    QueryPerformanceCounter(&start);
+    size_t reps = 0;
+    do
+    {
+        fpfunc(&vals[0], &ourdst[0], int(vals.size()));
+        reps += vals.size();
+        QueryPerformanceCounter(&end);
+    } while (end.QuadPart - start.QuadPart < min_timing_ticks);
+    eprint("{}: ticks = {:.2f}\n", name, double(end.QuadPart - start.QuadPart) / double(reps));
+    errs.print_report(name);
+}
+
 //
 // Control word:
 //   bits 11-10 = rounding control
@@ -1017,6 +1382,7 @@ int main(int argc, char *argv[])
     make_valuesi(valuesi16);
 
     validate_conversions();
+    print("SIMD tier: {}\n", host_tier_name(host_tier()));
 
     static std::array<x87cw_t, 3> const s_precision = { X87CW_PRECISION_EXTENDED, X87CW_PRECISION_DOUBLE, X87CW_PRECISION_SINGLE };
     static std::array<x87cw_t, 4> const s_round = { X87CW_ROUNDING_NEAREST, X87CW_ROUNDING_DOWN, X87CW_ROUNDING_UP, X87CW_ROUNDING_ZERO };
@@ -1060,6 +1426,58 @@ int main(int argc, char *argv[])
                 fld3280, values32, "fld32");
         }
 
+    for (uint32_t prec = 0; prec < s_precision.size(); prec++)
+        for (uint32_t round = 0; round < s_round.size(); round++)
+        {
+            x87cw_t cw = X87CW_MASK_ALL_EX | s_precision[prec] | s_round[round];
+            x87setcw(&cw);
+
+            print("Testing precision {} round {}\n", prec, round);
+
+            test_load_batch<fp80_t>(
+                [&](auto const *src, auto *dst, int count) { x87sw_t sw = 0; fp80_t::x87_fld64_batch(cw, sw, dst, src, count); return sw; },
+                fld6480, values64, "fld64_batch");
+        }
+
+    for (uint32_t prec = 0; prec < s_precision.size(); prec++)
+        for (uint32_t round = 0; round < s_round.size(); round++)
+        {
+            x87cw_t cw = X87CW_MASK_ALL_EX | s_precision[prec] | s_round[round];
+            x87setcw(&cw);
+
+            print("Testing precision {} round {}\n", prec, round);
+
+            test_load_batch<fp80_t>(
+                [&](auto const *src, auto *dst, int count) { fp80_array_t array(count); x87sw_t sw = 0; fp80_t::x87_fld64_batch(cw, sw, array, src); array.pack(dst); return sw; },
+                fld6480, values64, "fld64_array");
+        }
+
+    for (uint32_t prec = 0; prec < s_precision.size(); prec++)
+        for (uint32_t round = 0; round < s_round.size(); round++)
+        {
+            x87cw_t cw = X87CW_MASK_ALL_EX | s_precision[prec] | s_round[round];
+            x87setcw(&cw);
+
+            print("Testing precision {} round {}\n", prec, round);
+
+            test_load_batch<fp80_t>(
+                [&](auto const *src, auto *dst, int count) { x87sw_t sw = 0; fp80_t::x87_fld32_batch(cw, sw, dst, src, count); return sw; },
+                fld3280, values32, "fld32_batch");
+        }
+
+    for (uint32_t prec = 0; prec < s_precision.size(); prec++)
+        for (uint32_t round = 0; round < s_round.size(); round++)
+        {
+            x87cw_t cw = X87CW_MASK_ALL_EX | s_precision[prec] | s_round[round];
+            x87setcw(&cw);
+
+            print("Testing precision {} round {}\n", prec, round);
+
+            test_load_batch<fp80_t>(
+                [&](auto const *src, auto *dst, int count) { fp80_array_t array(count); x87sw_t sw = 0; fp80_t::x87_fld32_batch(cw, sw, array, src); array.pack(dst); return sw; },
+                fld3280, values32, "fld32_array");
+        }
+
     for (uint32_t prec = 0; prec < s_precision.size(); prec++)
         for (uint32_t round = 0; round < s_round.size(); round++)
         {
@@ -1099,6 +1517,123 @@ int main(int argc, char *argv[])
                 fild1680, valuesi16, "fild16");
         }
 
+    for (uint32_t prec = 0; prec < s_precision.size(); prec++)
+        for (uint32_t round = 0; round < s_round.size(); round++)
+        {
+            x87cw_t cw = X87CW_MASK_ALL_EX | s_precision[prec] | s_round[round];
+            x87setcw(&cw);
+
+            print("Testing precision {} round {}\n", prec, round);
+
+            test_load_batch<fp80_t>(
+                [&](auto const *src, auto *dst, int count) { x87sw_t sw = 0; fp80_t::x87_fild64_batch(cw, sw, dst, src, count); return sw; },
+                fild6480, valuesi64, "fild64_batch");
+        }
+
+    for (uint32_t prec = 0; prec < s_precision.size(); prec++)
+        for (uint32_t round = 0; round < s_round.size(); round++)
+        {
+            x87cw_t cw = X87CW_MASK_ALL_EX | s_precision[prec] | s_round[round];
+            x87setcw(&cw);
+
+            print("Testing precision {} round {}\n", prec, round);
+
+            test_load_batch<fp80_t>(
+                [&](auto const *src, auto *dst, int count) { fp80_array_t array(count); x87sw_t sw = 0; fp80_t::x87_fild64_batch(cw, sw, array, src); array.pack(dst); return sw; },
+                fild6480, valuesi64, "fild64_array");
+        }
+
+    for (uint32_t prec = 0; prec < s_precision.size(); prec++)
+        for (uint32_t round = 0; round < s_round.size(); round++)
+        {
+            x87cw_t cw = X87CW_MASK_ALL_EX | s_precision[prec] | s_round[round];
+            x87setcw(&cw);
+
+            print("Testing precision {} round {}\n", prec, round);
+
+            test_load_batch<fp80_t>(
+                [&](auto const *src, auto *dst, int count) { x87sw_t sw = 0; fp80_t::x87_fild32_batch(cw, sw, dst, src, count); return sw; },
+                fild3280, valuesi32, "fild32_batch");
+        }
+
+    for (uint32_t prec = 0; prec < s_precision.size(); prec++)
+        for (uint32_t round = 0; round < s_round.size(); round++)
+        {
+            x87cw_t cw = X87CW_MASK_ALL_EX | s_precision[prec] | s_round[round];
+            x87setcw(&cw);
+
+            print("Testing precision {} round {}\n", prec, round);
+
+            test_load_batch<fp80_t>(
+                [&](auto const *src, auto *dst, int count) { fp80_array_t array(count); x87sw_t sw = 0; fp80_t::x87_fild32_batch(cw, sw, array, src); array.pack(dst); return sw; },
+                fild3280, valuesi32, "fild32_array");
+        }
+
+    for (uint32_t prec = 0; prec < s_precision.size(); prec++)
+        for (uint32_t round = 0; round < s_round.size(); round++)
+        {
+            x87cw_t cw = X87CW_MASK_ALL_EX | s_precision[prec] | s_round[round];
+            x87setcw(&cw);
+
+            print("Testing precision {} round {}\n", prec, round);
+
+            test_load_batch<fp80_t>(
+                [&](auto const *src, auto *dst, int count) { x87sw_t sw = 0; fp80_t::x87_fild16_batch(cw, sw, dst, src, count); return sw; },
+                fild1680, valuesi16, "fild16_batch");
+        }
+
+    for (uint32_t prec = 0; prec < s_precision.size(); prec++)
+        for (uint32_t round = 0; round < s_round.size(); round++)
+        {
+            x87cw_t cw = X87CW_MASK_ALL_EX | s_precision[prec] | s_round[round];
+            x87setcw(&cw);
+
+            print("Testing precision {} round {}\n", prec, round);
+
+            test_load_batch<fp80_t>(
+                [&](auto const *src, auto *dst, int count) { fp80_array_t array(count); x87sw_t sw = 0; fp80_t::x87_fild16_batch(cw, sw, array, src); array.pack(dst); return sw; },
+                fild1680, valuesi16, "fild16_array");
+        }
+
+    for (uint32_t prec = 0; prec < s_precision.size(); prec++)
+        for (uint32_t round = 0; round < s_round.size(); round++)
+        {
+            x87cw_t cw = X87CW_MASK_ALL_EX | s_precision[prec] | s_round[round];
+            x87setcw(&cw);
+
+            print("Testing precision {} round {}\n", prec, round);
+
+            test_load_batch<fp64_t>(
+                [&](auto const *src, auto *dst, int count) { x87sw_t sw = 0; fp80_t::x87_fild64_batch(cw, sw, dst, src, count); return sw; },
+                fild6464, valuesi64, "fild64_batch(64)");
+        }
+
+    for (uint32_t prec = 0; prec < s_precision.size(); prec++)
+        for (uint32_t round = 0; round < s_round.size(); round++)
+        {
+            x87cw_t cw = X87CW_MASK_ALL_EX | s_precision[prec] | s_round[round];
+            x87setcw(&cw);
+
+            print("Testing precision {} round {}\n", prec, round);
+
+            test_load_batch<fp64_t>(
+                [&](auto const *src, auto *dst, int count) { x87sw_t sw = 0; fp80_t::x87_fild32_batch(cw, sw, dst, src, count); return sw; },
+                fild3264, valuesi32, "fild32_batch(64)");
+        }
+
+    for (uint32_t prec = 0; prec < s_precision.size(); prec++)
+        for (uint32_t round = 0; round < s_round.size(); round++)
+        {
+            x87cw_t cw = X87CW_MASK_ALL_EX | s_precision[prec] | s_round[round];
+            x87setcw(&cw);
+
+            print("Testing precision {} round {}\n", prec, round);
+
+            test_load_batch<fp64_t>(
+                [&](auto const *src, auto *dst, int count) { x87sw_t sw = 0; fp80_t::x87_fild16_batch(cw, sw, dst, src, count); return sw; },
+                fild1664, valuesi16, "fild16_batch(64)");
+        }
+
 
     for (uint32_t prec = 0; prec < s_precision.size(); prec++)
         for (uint32_t round = 0; round < s_round.size(); round++)
@@ -1139,6 +1674,58 @@ int main(int argc, char *argv[])
                 fst8032, values80, "fst32");
         }
 
+    for (uint32_t prec = 0; prec < s_precision.size(); prec++)
+        for (uint32_t round = 0; round < s_round.size(); round++)
+        {
+            x87cw_t cw = X87CW_MASK_ALL_EX | s_precision[prec] | s_round[round];
+            x87setcw(&cw);
+
+            print("Testing precision {} round {}\n", prec, round);
+
+            test_store_batch<fp64_t>(
+                [&](auto const *src, auto *dst, int count) { x87sw_t sw = 0; fp80_t::x87_fst64_batch(cw, sw, dst, src, count); return sw; },
+                fst8064, values80, "fst64_batch");
+        }
+
+    for (uint32_t prec = 0; prec < s_precision.size(); prec++)
+        for (uint32_t round = 0; round < s_round.size(); round++)
+        {
+            x87cw_t cw = X87CW_MASK_ALL_EX | s_precision[prec] | s_round[round];
+            x87setcw(&cw);
+
+            print("Testing precision {} round {}\n", prec, round);
+
+            test_store_batch<fp64_t>(
+                [&](auto const *src, auto *dst, int count) { fp80_array_t array(src, count); x87sw_t sw = 0; fp80_t::x87_fst64_batch(cw, sw, dst, array); return sw; },
+                fst8064, values80, "fst64_array");
+        }
+
+    for (uint32_t prec = 0; prec < s_precision.size(); prec++)
+        for (uint32_t round = 0; round < s_round.size(); round++)
+        {
+            x87cw_t cw = X87CW_MASK_ALL_EX | s_precision[prec] | s_round[round];
+            x87setcw(&cw);
+
+            print("Testing precision {} round {}\n", prec, round);
+
+            test_store_batch<float>(
+                [&](auto const *src, auto *dst, int count) { x87sw_t sw = 0; fp80_t::x87_fst32_batch(cw, sw, dst, src, count); return sw; },
+                fst8032, values80, "fst32_batch");
+        }
+
+    for (uint32_t prec = 0; prec < s_precision.size(); prec++)
+        for (uint32_t round = 0; round < s_round.size(); round++)
+        {
+            x87cw_t cw = X87CW_MASK_ALL_EX | s_precision[prec] | s_round[round];
+            x87setcw(&cw);
+
+            print("Testing precision {} round {}\n", prec, round);
+
+            test_store_batch<float>(
+                [&](auto const *src, auto *dst, int count) { fp80_array_t array(src, count); x87sw_t sw = 0; fp80_t::x87_fst32_batch(cw, sw, dst, array); return sw; },
+                fst8032, values80, "fst32_array");
+        }
+
     for (uint32_t prec = 0; prec < s_precision.size(); prec++)
         for (uint32_t round = 0; round < s_round.size(); round++)
         {
@@ -1178,23 +1765,124 @@ int main(int argc, char *argv[])
                 fist8016, values80, "fist16");
         }
 
+    for (uint32_t prec = 0; prec < s_precision.size(); prec++)
+        for (uint32_t round = 0; round < s_round.size(); round++)
+        {
+            x87cw_t cw = X87CW_MASK_ALL_EX | s_precision[prec] | s_round[round];
+            x87setcw(&cw);
+
+            print("Testing precision {} round {}\n", prec, round);
+
+            test_store_batch<int64_t>(
+                [&](auto const *src, auto *dst, int count) { x87sw_t sw = 0; fp80_t::x87_fist64_batch(cw, sw, dst, src, count); return sw; },
+                fist8064, values80, "fist64_batch");
+        }
+
+    for (uint32_t prec = 0; prec < s_precision.size(); prec++)
+        for (uint32_t round = 0; round < s_round.size(); round++)
+        {
+            x87cw_t cw = X87CW_MASK_ALL_EX | s_precision[prec] | s_round[round];
+            x87setcw(&cw);
+
+            print("Testing precision {} round {}\n", prec, round);
+
+            test_store_batch<int64_t>(
+                [&](auto const *src, auto *dst, int count) { fp80_array_t array(src, count); x87sw_t sw = 0; fp80_t::x87_fist64_batch(cw, sw, dst, array); return sw; },
+                fist8064, values80, "fist64_array");
+        }
+
+    for (uint32_t prec = 0; prec < s_precision.size(); prec++)
+        for (uint32_t round = 0; round < s_round.size(); round++)
+        {
+            x87cw_t cw = X87CW_MASK_ALL_EX | s_precision[prec] | s_round[round];
+            x87setcw(&cw);
+
+            print("Testing precision {} round {}\n", prec, round);
+
+            test_store_batch<int32_t>(
+                [&](auto const *src, auto *dst, int count) { x87sw_t sw = 0; fp80_t::x87_fist32_batch(cw, sw, dst, src, count); return sw; },
+                fist8032, values80, "fist32_batch");
+        }
+
+    for (uint32_t prec = 0; prec < s_precision.size(); prec++)
+        for (uint32_t round = 0; round < s_round.size(); round++)
+        {
+            x87cw_t cw = X87CW_MASK_ALL_EX | s_precision[prec] | s_round[round];
+            x87setcw(&cw);
+
+            print("Testing precision {} round {}\n", prec, round);
+
+            test_store_batch<int32_t>(
+                [&](auto const *src, auto *dst, int count) { fp80_array_t array(src, count); x87sw_t sw = 0; fp80_t::x87_fist32_batch(cw, sw, dst, array); return sw; },
+                fist8032, values80, "fist32_array");
+        }
+
+    for (uint32_t prec = 0; prec < s_precision.size(); prec++)
+        for (uint32_t round = 0; round < s_round.size(); round++)
+        {
+            x87cw_t cw = X87CW_MASK_ALL_EX | s_precision[prec] | s_round[round];
+            x87setcw(&cw);
+
+            print("Testing precision {} round {}\n", prec, round);
+
+            test_store_batch<int16_t>(
+                [&](auto const *src, auto *dst, int count) { x87sw_t sw = 0; fp80_t::x87_fist16_batch(cw, sw, dst, src, count); return sw; },
+                fist8016, values80, "fist16_batch");
+        }
+
+    for (uint32_t prec = 0; prec < s_precision.size(); prec++)
+        for (uint32_t round = 0; round < s_round.size(); round++)
+        {
+            x87cw_t cw = X87CW_MASK_ALL_EX | s_precision[prec] | s_round[round];
+            x87setcw(&cw);
+
+            print("Testing precision {} round {}\n", prec, round);
+
+            test_store_batch<int16_t>(
+                [&](auto const *src, auto *dst, int count) { fp80_array_t array(src, count); x87sw_t sw = 0; fp80_t::x87_fist16_batch(cw, sw, dst, array); return sw; },
+                fist8016, values80, "fist16_array");
+        }
+
+    // FXAM ignores the control word, so a single pass is enough; only the
+    // condition codes are compared
+    test_store_batch<uint16_t>(
+        [&](auto const *src, auto *dst, int count) { fp80_t::x87_fxam_batch(src, dst, count); return uint16_t(0); },
+        [&](auto const *src, auto *dst) { *dst = fxam80(src) & (X87SW_C3 | X87SW_C2 | X87SW_C1 | X87SW_C0); return uint16_t(0); },
+        values80, "fxam_batch(80)");
+    test_store_batch<uint16_t>(
+        [&](auto const *src, auto *dst, int count) { fp64_t::x87_fxam_batch(src, dst, count); return uint16_t(0); },
+        [&](auto const *src, auto *dst) { *dst = fxam64(src) & (X87SW_C3 | X87SW_C2 | X87SW_C1 | X87SW_C0); return uint16_t(0); },
+        values64, "fxam_batch(64)");
+
     // set round: to zero, precision: 53 bits
     cw = X87CW_MASK_ALL_EX | X87CW_ROUNDING_ZERO | X87CW_PRECISION_DOUBLE;
     x87setcw(&cw);
 
     test_unary64_2(&fp64_t::x87_fxtract, &fxtract64, "fxtract(64)", 1);
+    test_unary64_2_batch(&fp64_t::x87_fxtract_batch, &fxtract64, "fxtract_batch(64)", 1);
     test_unary64(&fp64_t::x87_f2xm1, &f2xm164, "f2xm1(64)", 2);
     test_unary64(&fp64_t::x87_fsin, &fsin64, "fsin(64)", 3);
     test_unary64(&fp64_t::x87_fcos, &fcos64, "fcos(64)", 3);
     test_unary64_2(&fp64_t::x87_fsincos, &fsincos64, "fsincos(64)", 3);
+    test_unary64_batch(&fp64_t::x87_f2xm1_batch, &f2xm164, "f2xm1_batch(64)", 2);
+    test_unary64_batch(&fp64_t::x87_fsin_batch, &fsin64, "fsin_batch(64)", 3);
+    test_unary64_batch(&fp64_t::x87_fcos_batch, &fcos64, "fcos_batch(64)", 3);
+    test_unary64_2_batch(&fp64_t::x87_fsincos_batch, &fsincos64, "fsincos_batch(64)", 3);
     test_unary64_2(&fp64_t::x87_fptan, &fptan64, "fptan(64)", 3);
+    test_unary64_2_batch(&fp64_t::x87_fptan_batch, &fptan64, "fptan_batch(64)", 3);
 
     test_binary64(&fp64_t::x87_fscale, &fscale64, "fscale(64)", 1);
     test_binary64(&fp64_t::x87_fprem, &fprem64, "fprem(64)", 1);
     test_binary64(&fp64_t::x87_fprem1, &fprem164, "fprem1(64)", 1);
+    test_binary64_batch(&fp64_t::x87_fscale_batch, &fscale64, "fscale_batch(64)", 1);
+    test_binary64_batch(&fp64_t::x87_fprem_batch, &fprem64, "fprem_batch(64)", 1);
+    test_binary64_batch(&fp64_t::x87_fprem1_batch, &fprem164, "fprem1_batch(64)", 1);
     test_binary64(&fp64_t::x87_fyl2xp1, &fyl2xp164, "fyl2xp1(64)", 3);
     test_binary64(&fp64_t::x87_fyl2x, &fyl2x64, "fyl2x(64)", 2);
+    test_binary64_batch(&fp64_t::x87_fyl2xp1_batch, &fyl2xp164, "fyl2xp1_batch(64)", 3);
+    test_binary64_batch(&fp64_t::x87_fyl2x_batch, &fyl2x64, "fyl2x_batch(64)", 2);
     test_binary64(&fp64_t::x87_fpatan, &fpatan64, "fpatan(64)", 3);
+    test_binary64_batch(&fp64_t::x87_fpatan_batch, &fpatan64, "fpatan_batch(64)", 3);
 
     // set round: to nearest, precision: 64 bits
     cw = X87CW_MASK_ALL_EX | X87CW_ROUNDING_NEAREST | X87CW_PRECISION_EXTENDED;
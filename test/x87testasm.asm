@@ -121,6 +121,33 @@ fild1680:
     fstp    tword [rdx]
     ret
 
+    global fild6464
+fild6464:
+    finit
+    fldcw   [rel saved_cw]
+    fild    qword [rcx]
+    fstsw   ax
+    fstp    qword [rdx]
+    ret
+
+    global fild3264
+fild3264:
+    finit
+    fldcw   [rel saved_cw]
+    fild    dword [rcx]
+    fstsw   ax
+    fstp    qword [rdx]
+    ret
+
+    global fild1664
+fild1664:
+    finit
+    fldcw   [rel saved_cw]
+    fild    word [rcx]
+    fstsw   ax
+    fstp    qword [rdx]
+    ret
+
     global fst8080
 fst8080:
     finit
@@ -175,6 +202,26 @@ fist8016:
     fstsw   ax
     ret
 
+    global fxam80
+fxam80:
+    finit
+    fldcw   [rel saved_cw]
+    fld     tword [rcx]
+    fxam
+    fstsw   ax
+    fstp    st0
+    ret
+
+    global fxam64
+fxam64:
+    finit
+    fldcw   [rel saved_cw]
+    fld     qword [rcx]
+    fxam
+    fstsw   ax
+    fstp    st0
+    ret
+
     global fadd80
 fadd80:
     finit
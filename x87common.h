@@ -47,6 +47,16 @@
 //
 #define X87_USE_CFENV (0)
 
+//
+// log2 of the number of f2xm1 table steps per unit; a larger table needs
+// fewer Taylor terms but touches more memory, so the best choice depends
+// on the deployment: 4 (R=16) is the default, and 6 (R=64) or 8 (R=256)
+// can be selected at build time
+//
+#ifndef X87_F2XM1_LOG_R
+#define X87_F2XM1_LOG_R (4)
+#endif
+
 //
 // all asserts within this code should by x87_assert; define x87_assert at build
 // time to map to your own assert macro if you prefer, otherwise we fall back to
@@ -57,9 +67,14 @@
 #define x87_assert assert
 #endif
 
+#include <bit>
+#include <cstddef>
 #include <cstdint>
+#include <cstdlib>
+#include <cstring>
 #include <cmath>
 #include <algorithm>
+#include <type_traits>
 
 #if X87_USE_CFENV
 #include <cfenv>
@@ -67,6 +82,36 @@
 #include <float.h>
 #endif
 
+//
+// the batch operations must match the scalar code bit for bit, and the
+// double-double helpers rely on exact error terms; both require that the
+// compiler never fuses a separate multiply and add, so this code must be
+// built with -ffp-contract=off on GCC/Clang (GCC otherwise contracts as
+// soon as FMA is enabled, e.g. with -march=native), and with /fp:precise
+// and without /fp:contract on MSVC
+//
+
+//
+// SIMD batch helpers are currently only implemented for x64 hosts; on
+// these, X87_SIMD_X64 is set and the AVX2 code paths are compiled in with
+// per-function target attributes, so no instruction set flags are needed;
+// the AVX-512 paths only use 256-bit vectors, for the extra instructions
+//
+#if defined(_M_X64) || defined(__x86_64__)
+#define X87_SIMD_X64 (1)
+#ifdef _MSC_VER
+#include <intrin.h>
+#define X87_TARGET_AVX2
+#define X87_TARGET_AVX512
+#else
+#include <cpuid.h>
+#define X87_TARGET_AVX2 __attribute__((target("avx2,bmi,bmi2,lzcnt,popcnt")))
+#define X87_TARGET_AVX512 __attribute__((target("avx2,bmi,bmi2,lzcnt,popcnt,avx512f,avx512dq,avx512cd,avx512bw,avx512vl")))
+#endif
+#else
+#define X87_SIMD_X64 (0)
+#endif
+
 
 //===========================================================================
 //
@@ -369,6 +414,7 @@ private:
 // multiply_64x64
 //
 // Perform a 64x64-bit multiplication and return the full 128-bit result.
+// All versions can be used in constant expressions.
 //
 //===========================================================================
 
@@ -377,12 +423,27 @@ namespace x87
 
 struct result128_t { uint64_t lo, hi; };
 
+//
+// portable version from 32x32-bit pieces, used when evaluating at compile time
+//
+constexpr result128_t multiply_64x64_portable(uint64_t a, uint64_t b)
+{
+    uint64_t lolo = (a & 0xffffffff) * (b & 0xffffffff);
+    uint64_t hilo = (a >> 32) * (b & 0xffffffff);
+    uint64_t lohi = (a & 0xffffffff) * (b >> 32);
+    uint64_t hihi = (a >> 32) * (b >> 32);
+    uint64_t mid = (lolo >> 32) + (hilo & 0xffffffff) + (lohi & 0xffffffff);
+    return { (mid << 32) | (lolo & 0xffffffff), hihi + (hilo >> 32) + (lohi >> 32) + (mid >> 32) };
+}
+
 #ifdef _MSC_VER
 
 #if defined(_M_X64)
 
-inline result128_t multiply_64x64(uint64_t a, uint64_t b)
+constexpr result128_t multiply_64x64(uint64_t a, uint64_t b)
 {
+    if (std::is_constant_evaluated())
+        return multiply_64x64_portable(a, b);
     result128_t result;
     result.lo = _umul128(a, b, &result.hi);
     return result;
@@ -392,8 +453,10 @@ inline result128_t multiply_64x64(uint64_t a, uint64_t b)
 
 extern "C" unsigned __int64 __umulh(unsigned __int64 a, unsigned __int64 b);
 #pragma intrinsic(__umulh)
-inline result128_t multiply_64x64(uint64_t a, uint64_t b)
+constexpr result128_t multiply_64x64(uint64_t a, uint64_t b)
 {
+    if (std::is_constant_evaluated())
+        return multiply_64x64_portable(a, b);
     return { a * b, __umulh(a, b) };
 }
 
@@ -401,15 +464,10 @@ inline result128_t multiply_64x64(uint64_t a, uint64_t b)
 
 #else
 
-inline result128_t multiply_64x64(uint64_t a, uint64_t b)
+constexpr result128_t multiply_64x64(uint64_t a, uint64_t b)
 {
-    union
-    {
-        result128_t result;
-        unsigned __int128 i128;
-    } u;
-    u.i128 = (unsigned __int128)a * b;
-    return u.result;
+    unsigned __int128 result = (unsigned __int128)a * b;
+    return { uint64_t(result), uint64_t(result >> 64) };
 }
 
 #endif
@@ -433,9 +491,11 @@ namespace x87
 //
 // count leading zeros in a 64-bit value
 //
-inline int count_leading_zeros64(uint64_t value)
+constexpr int count_leading_zeros64(uint64_t value)
 {
 #ifdef _MSC_VER
+    if (std::is_constant_evaluated())
+        return std::countl_zero(value);
     unsigned long index;
     return _BitScanReverse64(&index, value) ? (63 - index) : 64;
 #else
@@ -459,4 +519,189 @@ inline int count_trailing_zeros64(uint64_t value)
 
 }
 
+
+
+//===========================================================================
+//
+// select64
+//
+// Select between two 64-bit values with a mask instead of a branch, for
+// data-dependent conditions that would otherwise mispredict. Compilers are
+// free to turn a ternary back into a branch; this form keeps them honest.
+//
+//===========================================================================
+
+namespace x87
+{
+
+constexpr uint64_t select64(bool cond, uint64_t iftrue, uint64_t iffalse)
+{
+    uint64_t mask = uint64_t(0) - uint64_t(cond);
+    return iffalse ^ ((iftrue ^ iffalse) & mask);
+}
+
+}
+
+
+
+//===========================================================================
+//
+// host_tier
+// host_has_avx2
+// host_has_avx512
+//
+// Runtime detection of optional host instruction set extensions, used to
+// select between the SIMD and scalar versions of the batch helpers. CPUID
+// is probed once and the result cached, so each selection is just a load
+// and compare. The X87_SIMD_TIER environment variable can be set to
+// "scalar", "avx2", or "avx512" to cap the tier, which is useful for
+// benchmarking and for testing the fallback paths on capable hosts.
+//
+//===========================================================================
+
+namespace x87
+{
+
+//
+// SIMD tiers, in increasing order of capability
+//
+enum host_tier_t : uint8_t
+{
+    HOST_TIER_SCALAR,
+    HOST_TIER_AVX2,
+    HOST_TIER_AVX512
+};
+
+//
+// return a printable name for a tier
+//
+inline char const *host_tier_name(host_tier_t tier)
+{
+    return (tier == HOST_TIER_AVX512) ? "avx512" : (tier == HOST_TIER_AVX2) ? "avx2" : "scalar";
+}
+
+#if X87_SIMD_X64
+
+//
+// execute CPUID with the given leaf and subleaf
+//
+inline void host_cpuid(uint32_t leaf, uint32_t subleaf, uint32_t regs[4])
+{
+#ifdef _MSC_VER
+    int temp[4];
+    __cpuidex(temp, int(leaf), int(subleaf));
+    for (int index = 0; index < 4; index++)
+        regs[index] = uint32_t(temp[index]);
+#else
+    __cpuid_count(leaf, subleaf, regs[0], regs[1], regs[2], regs[3]);
+#endif
+}
+
+//
+// read the OS-enabled register state mask
+//
+inline uint64_t host_xgetbv0()
+{
+#ifdef _MSC_VER
+    return _xgetbv(0);
+#else
+    uint32_t lo, hi;
+    __asm__ volatile("xgetbv" : "=a"(lo), "=d"(hi) : "c"(0));
+    return (uint64_t(hi) << 32) | lo;
+#endif
+}
+
+//
+// return the best tier supported by the host; AVX2 also requires BMI1/2 and
+// LZCNT, which ship alongside it on all known implementations, and AVX-512
+// requires the F/DQ/CD/BW/VL subsets; in both cases the OS must save the
+// relevant register state
+//
+inline host_tier_t host_detect_tier()
+{
+    uint32_t regs[4];
+    host_cpuid(0, 0, regs);
+    if (regs[0] < 7)
+        return HOST_TIER_SCALAR;
+
+    // leaf 1: OSXSAVE (ECX bit 27) and AVX (ECX bit 28), then XMM/YMM state enabled
+    host_cpuid(1, 0, regs);
+    uint64_t xcr0 = ((regs[2] & (1 << 27)) != 0) ? host_xgetbv0() : 0;
+    if ((regs[2] & (3 << 27)) != (3 << 27) || (xcr0 & 6) != 6)
+        return HOST_TIER_SCALAR;
+
+    // leaf 7: AVX2 (EBX bit 5), BMI1 (EBX bit 3), BMI2 (EBX bit 8)
+    host_cpuid(7, 0, regs);
+    uint32_t leaf7ebx = regs[1];
+    if ((leaf7ebx & 0x128) != 0x128)
+        return HOST_TIER_SCALAR;
+
+    // leaf 0x80000001: LZCNT (ECX bit 5)
+    host_cpuid(0x80000001, 0, regs);
+    if ((regs[2] & 0x20) == 0)
+        return HOST_TIER_SCALAR;
+
+    // AVX512F (EBX bit 16), DQ (bit 17), CD (bit 28), BW (bit 30), VL (bit 31), plus opmask/ZMM state
+    if ((leaf7ebx & 0xd0030000) != 0xd0030000 || (xcr0 & 0xe6) != 0xe6)
+        return HOST_TIER_AVX2;
+    return HOST_TIER_AVX512;
+}
+
+#else
+
+inline host_tier_t host_detect_tier()
+{
+    return HOST_TIER_SCALAR;
+}
+
+#endif
+
+//
+// return the tier to use: the detected tier, capped by X87_SIMD_TIER if set
+//
+inline host_tier_t host_tier()
+{
+    static host_tier_t const s_result = []()
+    {
+        host_tier_t result = host_detect_tier();
+#ifdef _MSC_VER
+        char *value = nullptr;
+        size_t length = 0;
+        if (_dupenv_s(&value, &length, "X87_SIMD_TIER") != 0)
+            value = nullptr;
+#else
+        char const *value = std::getenv("X87_SIMD_TIER");
+#endif
+        if (value != nullptr)
+        {
+            for (host_tier_t tier : { HOST_TIER_SCALAR, HOST_TIER_AVX2, HOST_TIER_AVX512 })
+                if (std::strcmp(value, host_tier_name(tier)) == 0)
+                    result = std::min(result, tier);
+#ifdef _MSC_VER
+            free(value);
+#endif
+        }
+        return result;
+    }();
+    return s_result;
+}
+
+//
+// return true if the AVX2 versions should be used
+//
+inline bool host_has_avx2()
+{
+    return (host_tier() >= HOST_TIER_AVX2);
+}
+
+//
+// return true if the AVX-512 versions should be used
+//
+inline bool host_has_avx512()
+{
+    return (host_tier() >= HOST_TIER_AVX512);
+}
+
+}
+
 #endif
@@ -63,11 +63,11 @@ public:
     //
     // construction/destruction
     //
-    explicit fp64_t() { }
-    fp64_t(fp64_t const &v64) { m_value.d = v64.m_value.d; }
+    constexpr explicit fp64_t() { }
+    constexpr fp64_t(fp64_t const &v64) : m_value(v64.m_value) { }
     explicit fp64_t(fp80_t const &v80) { m_value.d = v80.as_double(); }
     explicit fp64_t(uint64_t man, uint16_t se) { m_value.d = fp80_t(man, se).as_double(); }
-    fp64_t(double _val) { m_value.d = _val; }
+    constexpr fp64_t(double _val) { m_value.d = _val; }
     explicit fp64_t(float _val) { m_value.d = double(_val); }
     explicit fp64_t(int64_t _val) { m_value.d = double(_val); }
     explicit fp64_t(int32_t _val) { m_value.d = double(_val); }
@@ -98,7 +98,7 @@ public:
     uint64_t mantissa() const { return m_value.i & FP64_MANTISSA_MASK; }
     int32_t exponent() const { return ((m_value.i & FP64_EXPONENT_MASK) >> FP64_EXPONENT_SHIFT) - FP64_EXPONENT_BIAS; }
     uint8_t sign() const { return m_value.i >> FP64_SIGN_SHIFT; }
-    uint64_t as_fpbits64() const { return m_value.i; }
+    constexpr uint64_t as_fpbits64() const { return std::bit_cast<uint64_t>(m_value.d); }
     uint32_t as_fpbits32() const { float_int32_t u = { float(m_value.d) }; return u.i; }
 
     //
@@ -112,7 +112,7 @@ public:
     int64_t as_int64(x87cw_t round) const { fpround_t r(round); return int64_t(m_value.d); }
     float as_float() const { return float(m_value.d); }
     float as_float(x87cw_t round) const { fpround_t r(round); return float(m_value.d); }
-    double as_double(x87cw_t round = X87CW_ROUNDING_NEAREST) const { return m_value.d; }
+    constexpr double as_double(x87cw_t round = X87CW_ROUNDING_NEAREST) const { return m_value.d; }
     fp80_t as_fp80() const { return fp80_t(m_value.d); }
 
     //
@@ -134,20 +134,20 @@ public:
     //
     // static constants
     //
-    static fp64_t const_zero()  { static int64_double_t const c = { 0x0000000000000000 }; return fp64_t(c.d); }
-    static fp64_t const_nzero() { static int64_double_t const c = { 0x8000000000000000 }; return fp64_t(c.d); }
-    static fp64_t const_one()   { static int64_double_t const c = { 0x3ff0000000000000 }; return fp64_t(c.d); }
-    static fp64_t const_none()  { static int64_double_t const c = { 0xbff0000000000000 }; return fp64_t(c.d); }
-    static fp64_t const_2t()    { static int64_double_t const c = { 0x400a934f0979a371 }; return fp64_t(c.d); }
-    static fp64_t const_2e()    { static int64_double_t const c = { 0x3ff71547652b82fe }; return fp64_t(c.d); }
-    static fp64_t const_pi()    { static int64_double_t const c = { 0x400921fb54442d18 }; return fp64_t(c.d); }
-    static fp64_t const_lg2()   { static int64_double_t const c = { 0x3fd34413509f79ff }; return fp64_t(c.d); }
-    static fp64_t const_ln2()   { static int64_double_t const c = { 0x3fe62e42fefa39ef }; return fp64_t(c.d); }
-    static fp64_t const_snan()  { static int64_double_t const c = { 0x7ff0000000000001 }; return fp64_t(c.d); }
-    static fp64_t const_qnan()  { static int64_double_t const c = { 0x7ff8000000000000 }; return fp64_t(c.d); }
-    static fp64_t const_pinf()  { static int64_double_t const c = { 0x7ff0000000000000 }; return fp64_t(c.d); }
-    static fp64_t const_ninf()  { static int64_double_t const c = { 0xfff0000000000000 }; return fp64_t(c.d); }
-    static fp64_t const_indef() { static int64_double_t const c = { 0xfff8000000000000 }; return fp64_t(c.d); }
+    static constexpr fp64_t const_zero()  { return from_fpbits64(0x0000000000000000); }
+    static constexpr fp64_t const_nzero() { return from_fpbits64(0x8000000000000000); }
+    static constexpr fp64_t const_one()   { return from_fpbits64(0x3ff0000000000000); }
+    static constexpr fp64_t const_none()  { return from_fpbits64(0xbff0000000000000); }
+    static constexpr fp64_t const_2t()    { return from_fpbits64(0x400a934f0979a371); }
+    static constexpr fp64_t const_2e()    { return from_fpbits64(0x3ff71547652b82fe); }
+    static constexpr fp64_t const_pi()    { return from_fpbits64(0x400921fb54442d18); }
+    static constexpr fp64_t const_lg2()   { return from_fpbits64(0x3fd34413509f79ff); }
+    static constexpr fp64_t const_ln2()   { return from_fpbits64(0x3fe62e42fefa39ef); }
+    static constexpr fp64_t const_snan()  { return from_fpbits64(0x7ff0000000000001); }
+    static constexpr fp64_t const_qnan()  { return from_fpbits64(0x7ff8000000000000); }
+    static constexpr fp64_t const_pinf()  { return from_fpbits64(0x7ff0000000000000); }
+    static constexpr fp64_t const_ninf()  { return from_fpbits64(0xfff0000000000000); }
+    static constexpr fp64_t const_indef() { return from_fpbits64(0xfff8000000000000); }
 
     //
     // static unary ops
@@ -166,6 +166,7 @@ public:
     //
     // x87 ops
     //
+    static uint16_t x87_fxam(fp64_t const &src);
     static uint16_t x87_fxtract(fp64_t const &src, fp64_t &dst1, fp64_t &dst2);
     static uint16_t x87_fscale(fp64_t const &src1, fp64_t const &src2, fp64_t &dst);
     static uint16_t x87_fprem(fp64_t const &src1, fp64_t const &src2, fp64_t &dst);
@@ -179,12 +180,31 @@ public:
     static uint16_t x87_fptan(fp64_t const &src, fp64_t &dst1, fp64_t &dst2);
     static uint16_t x87_fpatan(fp64_t const &src1, fp64_t const &src2, fp64_t &dst);
 
+    //
+    // x87 batch ops; results match calling the ops above on each element in
+    // turn, and the returned flags are accumulated across all elements;
+    // x87_fxam_batch instead writes the condition codes for each element
+    //
+    static void x87_fxam_batch(fp64_t const *src, uint16_t *dst, size_t count);
+    static uint16_t x87_fxtract_batch(fp64_t const *src, fp64_t *dst1, fp64_t *dst2, size_t count);
+    static uint16_t x87_fscale_batch(fp64_t const *src1, fp64_t const *src2, fp64_t *dst, size_t count);
+    static uint16_t x87_fprem_batch(fp64_t const *src1, fp64_t const *src2, fp64_t *dst, size_t count);
+    static uint16_t x87_fprem1_batch(fp64_t const *src1, fp64_t const *src2, fp64_t *dst, size_t count);
+    static uint16_t x87_f2xm1_batch(fp64_t const *src, fp64_t *dst, size_t count);
+    static uint16_t x87_fyl2x_batch(fp64_t const *src1, fp64_t const *src2, fp64_t *dst, size_t count);
+    static uint16_t x87_fyl2xp1_batch(fp64_t const *src1, fp64_t const *src2, fp64_t *dst, size_t count);
+    static uint16_t x87_fsin_batch(fp64_t const *src, fp64_t *dst, size_t count);
+    static uint16_t x87_fcos_batch(fp64_t const *src, fp64_t *dst, size_t count);
+    static uint16_t x87_fsincos_batch(fp64_t const *src, fp64_t *dst1, fp64_t *dst2, size_t count);
+    static uint16_t x87_fptan_batch(fp64_t const *src, fp64_t *dst1, fp64_t *dst2, size_t count);
+    static uint16_t x87_fpatan_batch(fp64_t const *src1, fp64_t const *src2, fp64_t *dst, size_t count);
+
     //
     // static misc ops
     //
     static fp64_t make_qnan(fp64_t const &src) { x87_assert(src.isnan()); fp64_t result(src); result.m_value.i |= 0x0008000000000000ull; return result; }
     static fp64_t from_fpbits32(uint32_t bits) { int32_float_t u = { bits }; return fp64_t(u.d); }
-    static fp64_t from_fpbits64(uint64_t bits) { fp64_t result; result.m_value.i = bits; return result; }
+    static constexpr fp64_t from_fpbits64(uint64_t bits) { fp64_t result; result.m_value.d = std::bit_cast<double>(bits); return result; }
     static bool samesign(fp64_t const &src1, fp64_t const &src2) { return (((src1.m_value.i ^ src2.m_value.i) & FP64_SIGN_MASK) == 0); }
 
 protected:
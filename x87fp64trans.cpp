@@ -116,10 +116,12 @@
 
 #include "x87fp64.h"
 #include "x87fpext.h"
+#include "x87simd.h"
 
 #include <cstdint>
 #include <cmath>
 #include <array>
+#include <utility>
 
 namespace x87
 {
@@ -259,8 +261,9 @@ void print_val(char const *name, fpext96_t const &val)
 //
 // poly_eval / poly1_eval
 //
-// Evaluate a polynomial by iterating over an array of terms. Derived from
-// the Cephes math library, found here: https://netlib.org/cephes/
+// Evaluate a polynomial by iterating over an array of terms, either a
+// std::array or a packed fpext_table_t. Derived from the Cephes math
+// library, found here: https://netlib.org/cephes/
 //
 //===========================================================================
 
@@ -268,12 +271,11 @@ void print_val(char const *name, fpext96_t const &val)
 // polynomial evaluator of the form
 //    P[0] x^n  +  P[1] x^(n-1)  +  ...  +  P[n]
 //
-template<typename FpType, size_t Count>
-FpType poly_eval(FpType const &x, std::array<FpType, Count> const &terms)
+template<typename FpType, typename TermsType>
+FpType poly_eval(FpType const &x, TermsType const &terms)
 {
-    int index = 0;
     FpType dst = terms[0];
-    for (int index = 1; index < Count; index++)
+    for (size_t index = 1; index < terms.size(); index++)
         dst = dst * x + terms[index];
     return dst;
 }
@@ -282,16 +284,324 @@ FpType poly_eval(FpType const &x, std::array<FpType, Count> const &terms)
 // polynomial evalutaor of the form
 //    x^n  +  P[0] x^(n-1)  +  P[1] x^(n-2)  +  ...  +  P[n]
 //
-template<typename FpType, size_t Count>
-FpType poly1_eval(FpType const &x, std::array<FpType, Count> const &terms)
+template<typename FpType, typename TermsType>
+FpType poly1_eval(FpType const &x, TermsType const &terms)
 {
-    int index = 0;
     FpType dst = x + terms[0];
-    for (int index = 1; index < Count; index++)
+    for (size_t index = 1; index < terms.size(); index++)
         dst = dst * x + terms[index];
     return dst;
 }
 
+#if X87_SIMD_X64
+
+//
+// 4-lane versions of the above for fpext52_t terms; the multiplies and adds
+// are kept separate so that results match the scalar versions exactly
+//
+template<size_t Count>
+X87_TARGET_AVX2 inline __m256d poly_eval_x4(__m256d x, std::array<fpext52_t, Count> const &terms)
+{
+    __m256d dst = _mm256_set1_pd(terms[0].as_double());
+    for (size_t index = 1; index < Count; index++)
+        dst = _mm256_add_pd(_mm256_mul_pd(dst, x), _mm256_set1_pd(terms[index].as_double()));
+    return dst;
+}
+
+template<size_t Count>
+X87_TARGET_AVX2 inline __m256d poly1_eval_x4(__m256d x, std::array<fpext52_t, Count> const &terms)
+{
+    __m256d dst = _mm256_add_pd(x, _mm256_set1_pd(terms[0].as_double()));
+    for (size_t index = 1; index < Count; index++)
+        dst = _mm256_add_pd(_mm256_mul_pd(dst, x), _mm256_set1_pd(terms[index].as_double()));
+    return dst;
+}
+
+//
+// 4-lane versions for packed fpext64_t terms
+//
+template<size_t Count>
+X87_TARGET_AVX2 inline fpext64x4_t poly_eval_x4(fpext64x4_t const &x, fpext_table_t<uint8_t, Count> const &terms)
+{
+    fpext64x4_t dst(terms[0]);
+    for (size_t index = 1; index < Count; index++)
+        dst = fpext64x4_t::add(fpext64x4_t::mul(dst, x), fpext64x4_t(terms[index]));
+    return dst;
+}
+
+template<size_t Count>
+X87_TARGET_AVX2 inline fpext64x4_t poly1_eval_x4(fpext64x4_t const &x, fpext_table_t<uint8_t, Count> const &terms)
+{
+    fpext64x4_t dst = fpext64x4_t::add(x, fpext64x4_t(terms[0]));
+    for (size_t index = 1; index < Count; index++)
+        dst = fpext64x4_t::add(fpext64x4_t::mul(dst, x), fpext64x4_t(terms[index]));
+    return dst;
+}
+
+#endif
+
+
+
+//===========================================================================
+//
+// poly_eval_unrolled / poly_eval_estrin
+//
+// Alternative evaluators for the same polynomial forms as poly_eval and
+// poly1_eval, selectable per call site. The unrolled versions take the
+// coefficient array as a template parameter and expand the Horner steps
+// at compile time. The Estrin versions pair up terms with successive
+// squares of x, shortening the dependency chain from n steps to about
+// log2(n) at the cost of slightly different rounding.
+//
+//===========================================================================
+
+//
+// Horner evaluation over a compile-time coefficient pack
+//
+template<auto const &Terms, typename FpType, size_t... Index>
+FpType poly_eval_unrolled(FpType const &x, FpType dst, std::index_sequence<Index...>)
+{
+    ((dst = FpType::fma(dst, x, FpType(Terms[Index + 1]))), ...);
+    return dst;
+}
+
+//
+// polynomial evaluator of the form
+//    P[0] x^n  +  P[1] x^(n-1)  +  ...  +  P[n]
+//
+template<auto const &Terms, typename FpType>
+FpType poly_eval_unrolled(FpType const &x)
+{
+    return poly_eval_unrolled<Terms>(x, FpType(Terms[0]), std::make_index_sequence<Terms.size() - 1>());
+}
+
+//
+// polynomial evaluator of the form
+//    x^n  +  P[0] x^(n-1)  +  P[1] x^(n-2)  +  ...  +  P[n]
+//
+template<auto const &Terms, typename FpType>
+FpType poly1_eval_unrolled(FpType const &x)
+{
+    return poly_eval_unrolled<Terms>(x, x + FpType(Terms[0]), std::make_index_sequence<Terms.size() - 1>());
+}
+
+//
+// Estrin evaluation of the first Count terms, with an implied leading 1 if
+// Monic; the first level pairs up the descending terms directly, and later
+// levels combine the results in place with successive squares of x
+//
+template<typename FpType, size_t Count, bool Monic, typename TermsType>
+FpType estrin_eval(FpType const &x, TermsType const &terms)
+{
+    constexpr size_t Total = Count + (Monic ? 1 : 0);
+    std::array<FpType, Total> term;
+    for (size_t index = 0; index < Total; index++)
+        term[index] = (Monic && index == 0) ? FpType::one : FpType(terms[index - (Monic ? 1 : 0)]);
+
+    std::array<FpType, (Total + 1) / 2> coeff;
+    for (size_t index = 0; index < Total / 2; index++)
+        coeff[index] = FpType::fma(term[Total - 2 - 2 * index], x, term[Total - 1 - 2 * index]);
+    if ((Total & 1) != 0)
+        coeff[Total / 2] = term[0];
+
+    FpType power = x * x;
+    for (size_t count = (Total + 1) / 2; count > 1; count = (count + 1) / 2)
+    {
+        for (size_t index = 0; index < count / 2; index++)
+            coeff[index] = FpType::fma(coeff[2 * index + 1], power, coeff[2 * index]);
+        if ((count & 1) != 0)
+            coeff[count / 2] = coeff[count - 1];
+        if (count > 2)
+            power = power * power;
+    }
+    return coeff[0];
+}
+
+//
+// polynomial evaluator of the form
+//    P[0] x^n  +  P[1] x^(n-1)  +  ...  +  P[n]
+//
+template<typename FpType, typename TermsType>
+FpType poly_eval_estrin(FpType const &x, TermsType const &terms)
+{
+    return estrin_eval<FpType, std::tuple_size_v<TermsType>, false>(x, terms);
+}
+
+//
+// polynomial evaluator of the form
+//    x^n  +  P[0] x^(n-1)  +  P[1] x^(n-2)  +  ...  +  P[n]
+//
+template<typename FpType, typename TermsType>
+FpType poly1_eval_estrin(FpType const &x, TermsType const &terms)
+{
+    return estrin_eval<FpType, std::tuple_size_v<TermsType>, true>(x, terms);
+}
+
+#if X87_SIMD_X64
+
+//
+// 4-lane version of estrin_eval for fpext52_t; the multiplies and adds are
+// done in the same order so that results match the scalar version exactly
+//
+template<size_t Count, bool Monic, typename TermsType>
+X87_TARGET_AVX2 inline __m256d estrin_eval_x4(__m256d x, TermsType const &terms)
+{
+    constexpr size_t Total = Count + (Monic ? 1 : 0);
+    __m256d term[Total];
+    for (size_t index = 0; index < Total; index++)
+        term[index] = _mm256_set1_pd((Monic && index == 0) ? 1.0 : fpext52_t(terms[index - (Monic ? 1 : 0)]).as_double());
+
+    __m256d coeff[(Total + 1) / 2];
+    for (size_t index = 0; index < Total / 2; index++)
+        coeff[index] = _mm256_add_pd(_mm256_mul_pd(term[Total - 2 - 2 * index], x), term[Total - 1 - 2 * index]);
+    if ((Total & 1) != 0)
+        coeff[Total / 2] = term[0];
+
+    __m256d power = _mm256_mul_pd(x, x);
+    for (size_t count = (Total + 1) / 2; count > 1; count = (count + 1) / 2)
+    {
+        for (size_t index = 0; index < count / 2; index++)
+            coeff[index] = _mm256_add_pd(_mm256_mul_pd(coeff[2 * index + 1], power), coeff[2 * index]);
+        if ((count & 1) != 0)
+            coeff[count / 2] = coeff[count - 1];
+        if (count > 2)
+            power = _mm256_mul_pd(power, power);
+    }
+    return coeff[0];
+}
+
+#endif
+
+
+
+//===========================================================================
+//
+// poly_eval_compensated
+//
+// Compensated Horner evaluation over plain doubles (Graillat, Langlois and
+// Louvet). The rounding error of each step is recovered exactly with
+// two_prod/two_sum and run through a second Horner recurrence, giving
+// results about as accurate as Horner in twice the precision. The argument
+// and result are double-doubles so that the reduced value can carry its
+// low bits in. The first Head terms can instead be run through a plain
+// Estrin evaluation when the remaining powers of x shrink their rounding
+// error well below that of the result.
+//
+//===========================================================================
+
+//
+// convert an array of fpext52_t terms to plain doubles, appending any
+// extra trailing terms
+//
+template<size_t Count, typename... Extra>
+constexpr auto compensated_terms(std::array<fpext52_t, Count> const &terms, Extra... extra)
+{
+    return [&]<size_t... Index>(std::index_sequence<Index...>)
+    {
+        return std::array<double, Count + sizeof...(Extra)>{ terms[Index].as_double()..., double(extra)... };
+    }(std::make_index_sequence<Count>());
+}
+
+//
+// polynomial evaluator of the form
+//    P[0] x^n  +  P[1] x^(n-1)  +  ...  +  P[n]
+// with P[0] through P[Head-1] evaluated by estrin_eval on the high part of x
+//
+template<size_t Head, size_t Count>
+fpext106_t poly_eval_compensated(fpext106_t const &x, std::array<double, Count> const &terms)
+{
+    double sum = estrin_eval<fpext52_t, Head, false>(fpext52_t(x.hi()), terms).as_double();
+    double err = 0.0;
+    for (size_t index = Head; index < Count; index++)
+    {
+        fpext106_t prod = fpext106_t::two_prod(sum, x.hi());
+        fpext106_t next = fpext106_t::two_sum(prod.hi(), terms[index]);
+        err = err * x.hi() + ((prod.lo() + next.lo()) + sum * x.lo());
+        sum = next.hi();
+    }
+    return fpext106_t::quick_two_sum(sum, err);
+}
+
+#if X87_SIMD_X64
+
+//
+// 4-lane version of the above; the operations are done in the same order
+// so that results match the scalar version exactly
+//
+template<size_t Head, size_t Count>
+X87_TARGET_AVX2 inline void poly_eval_compensated_x4(__m256d xhi, __m256d xlo, std::array<double, Count> const &terms, __m256d &hi, __m256d &lo)
+{
+    __m256d sum = estrin_eval_x4<Head, false>(xhi, terms);
+    __m256d err = _mm256_setzero_pd();
+    for (size_t index = Head; index < Count; index++)
+    {
+        __m256d prodhi, prodlo, nexthi, nextlo;
+        two_prod_x4(sum, xhi, prodhi, prodlo);
+        two_sum_x4(prodhi, _mm256_set1_pd(terms[index]), nexthi, nextlo);
+        err = _mm256_add_pd(_mm256_mul_pd(err, xhi), _mm256_add_pd(_mm256_add_pd(prodlo, nextlo), _mm256_mul_pd(sum, xlo)));
+        sum = nexthi;
+    }
+    quick_two_sum_x4(sum, err, hi, lo);
+}
+
+#endif
+
+
+
+//===========================================================================
+//
+// x87_fxam
+//
+// Classify a value, returning the C3/C2/C0 class code with C1 set to the
+// sign. Denormals are classified as normal, matching what FXAM reports
+// after loading them into an 80-bit register. The batch version is fully
+// vectorized, since no lane ever needs the scalar code.
+//
+//===========================================================================
+
+uint16_t fp64_t::x87_fxam(fp64_t const &src)
+{
+    uint16_t result = src.sign() ? X87SW_C1 : 0;
+    if (src.iszero())
+        return result | X87SW_C3;
+    if (src.ismaxexp())
+        return result | (src.isinf() ? (X87SW_C2 | X87SW_C0) : X87SW_C0);
+    return result | X87SW_C2;
+}
+
+//
+// batch kernel; no flags are possible and there are no special lanes
+//
+struct fxam_batch_kernel
+{
+    //
+    // scalar version
+    //
+    static uint16_t scalar(size_t index, fp64_t const *src, uint16_t *dst)
+    {
+        dst[index] = fp64_t::x87_fxam(src[index]);
+        return 0;
+    }
+
+#if X87_SIMD_X64
+    //
+    // AVX2 version
+    //
+    X87_TARGET_AVX2 static __m256i avx2(size_t index, __m256i &, fp64_t const *src, uint16_t *dst)
+    {
+        __m256i codes = fxam_fp64_x4(_mm256_loadu_si256(reinterpret_cast<__m256i const *>(&src[index])));
+        __m128i packed = _mm256_castsi256_si128(_mm256_permutevar8x32_epi32(codes, _mm256_setr_epi32(0, 2, 4, 6, 1, 3, 5, 7)));
+        _mm_storel_epi64(reinterpret_cast<__m128i *>(&dst[index]), _mm_packus_epi32(packed, packed));
+        return _mm256_setzero_si256();
+    }
+#endif
+};
+
+void fp64_t::x87_fxam_batch(fp64_t const *src, uint16_t *dst, size_t count)
+{
+    run_batch<fxam_batch_kernel>(count, src, dst);
+}
+
 
 
 //===========================================================================
@@ -351,6 +661,50 @@ zero:
 }
 
 
+//
+// batch kernel
+//
+struct fxtract_batch_kernel
+{
+    //
+    // scalar version
+    //
+    static uint16_t scalar(size_t index, fp64_t const *src, fp64_t *dst1, fp64_t *dst2)
+    {
+        return fp64_t::x87_fxtract(src[index], dst1[index], dst2[index]);
+    }
+
+#if X87_SIMD_X64
+    //
+    // AVX2 version: for normal values the significand is just the source with
+    // its exponent field replaced, and the unbiased exponent converts exactly
+    // to a double; no flags are possible, so zeros, denormals, infinities, and
+    // NaNs are the only lanes redone by the scalar code
+    //
+    X87_TARGET_AVX2 static __m256i avx2(size_t index, __m256i &, fp64_t const *src, fp64_t *dst1, fp64_t *dst2)
+    {
+        __m256i const expmask = _mm256_set1_epi64x(FP64_EXPONENT_MASK);
+        __m256i const onebits = _mm256_set1_epi64x(int64_t(FP64_EXPONENT_BIAS) << FP64_EXPONENT_SHIFT);
+        __m256i const bias = _mm256_set1_epi64x(FP64_EXPONENT_BIAS);
+
+        __m256i srcbits = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(&src[index]));
+        __m256i special = slowpath_fp64_x4(srcbits);
+
+        __m256i exponent = _mm256_sub_epi64(_mm256_srli_epi64(_mm256_and_si256(srcbits, expmask), FP64_EXPONENT_SHIFT), bias);
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(&dst1[index]), _mm256_or_si256(_mm256_andnot_si256(expmask, srcbits), onebits));
+        _mm256_storeu_pd(reinterpret_cast<double *>(&dst2[index]), cvtepi64_pd_small_x4(exponent));
+
+        return special;
+    }
+#endif
+};
+
+uint16_t fp64_t::x87_fxtract_batch(fp64_t const *src, fp64_t *dst1, fp64_t *dst2, size_t count)
+{
+    return run_batch<fxtract_batch_kernel>(count, src, dst1, dst2);
+}
+
+
 
 //===========================================================================
 //
@@ -463,6 +817,64 @@ zero:
 }
 
 
+//
+// batch kernel
+//
+struct fscale_batch_kernel
+{
+    //
+    // scalar version
+    //
+    static uint16_t scalar(size_t index, fp64_t const *src1, fp64_t const *src2, fp64_t *dst)
+    {
+        return fp64_t::x87_fscale(src1[index], src2[index], dst[index]);
+    }
+
+#if X87_SIMD_X64
+    //
+    // AVX2 version: when src1 is normal and the scaled result stays normal,
+    // FSCALE is an exact integer add into the exponent field and sets no
+    // flags. Lanes with a zero, denormal, infinite, or NaN src1, a denormal,
+    // infinite, or NaN src2, or a result outside the normal range are redone
+    // by the scalar code
+    //
+    X87_TARGET_AVX2 static __m256i avx2(size_t index, __m256i &, fp64_t const *src1, fp64_t const *src2, fp64_t *dst)
+    {
+        __m256i const expmask = _mm256_set1_epi64x(FP64_EXPONENT_MASK);
+        __m256i const zero = _mm256_setzero_si256();
+        __m256d const absmask = _mm256_castsi256_pd(_mm256_set1_epi64x(FP64_ABS_MASK));
+
+        __m256i src1bits = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(&src1[index]));
+        __m256i src2bits = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(&src2[index]));
+
+        // src1 must be normal; src2 may also be zero
+        __m256i exp2 = _mm256_and_si256(src2bits, expmask);
+        __m256i src2zero = _mm256_cmpeq_epi64(_mm256_and_si256(src2bits, _mm256_castpd_si256(absmask)), zero);
+        __m256i special = _mm256_or_si256(slowpath_fp64_x4(src1bits),
+            _mm256_or_si256(_mm256_cmpeq_epi64(exp2, expmask), _mm256_andnot_si256(src2zero, _mm256_cmpeq_epi64(exp2, zero))));
+
+        // round the scale toward zero; anything at or beyond +/-32768 is special
+        __m256d scale = _mm256_round_pd(_mm256_castsi256_pd(src2bits), _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC);
+        special = _mm256_or_si256(special, _mm256_castpd_si256(_mm256_cmp_pd(_mm256_and_pd(scale, absmask), _mm256_set1_pd(32768.0), _CMP_GE_OQ)));
+        __m256i iexp = _mm256_cvtepi32_epi64(_mm256_cvttpd_epi32(scale));
+
+        // results that would overflow or go denormal are special
+        __m256i newexp = _mm256_add_epi64(_mm256_srli_epi64(_mm256_and_si256(src1bits, expmask), FP64_EXPONENT_SHIFT), iexp);
+        special = _mm256_or_si256(special, _mm256_or_si256(_mm256_cmpgt_epi64(_mm256_set1_epi64x(1), newexp),
+            _mm256_cmpgt_epi64(newexp, _mm256_set1_epi64x(FP64_EXPONENT_MAX_BIASED - 1))));
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(&dst[index]), _mm256_add_epi64(src1bits, _mm256_slli_epi64(iexp, FP64_EXPONENT_SHIFT)));
+
+        return special;
+    }
+#endif
+};
+
+uint16_t fp64_t::x87_fscale_batch(fp64_t const *src1, fp64_t const *src2, fp64_t *dst, size_t count)
+{
+    return run_batch<fscale_batch_kernel>(count, src1, src2, dst);
+}
+
+
 
 //===========================================================================
 //
@@ -619,6 +1031,129 @@ uint16_t fp64_t::x87_fprem1(fp64_t const &src1, fp64_t const &src2, fp64_t &dst)
 }
 
 
+//
+// batch kernel
+//
+template<bool Rem1>
+struct fprem_batch_kernel
+{
+    //
+    // scalar version
+    //
+    static uint16_t scalar(size_t index, fp64_t const *src1, fp64_t const *src2, fp64_t *dst)
+    {
+        return x87_fprem_core<Rem1>(src1[index], src2[index], dst[index]);
+    }
+
+#if X87_SIMD_X64
+    //
+    // AVX2 version: for normal sources whose exponents differ by at most 63,
+    // the remainder is computed by long division on the 53-bit significands,
+    // producing up to 26 quotient bits per step and iterating only as long as
+    // some lane still has quotient bits left. The remainder and its scale
+    // factor are then converted exactly to doubles and multiplied. Zeros, denormals,
+    // infinities, NaNs, partial remainders, and divisors small enough that
+    // the remainder could be denormal are redone by the scalar code
+    //
+    X87_TARGET_AVX2 static __m256i avx2(size_t index, __m256i &flags, fp64_t const *src1, fp64_t const *src2, fp64_t *dst)
+    {
+        __m256i const expmask = _mm256_set1_epi64x(FP64_EXPONENT_MASK);
+        __m256i const mantmask = _mm256_set1_epi64x(FP64_MANTISSA_MASK);
+        __m256i const implicit_one = _mm256_set1_epi64x(1ll << FP64_MANTISSA_BITS);
+        __m256i const signmask = _mm256_set1_epi64x(FP64_SIGN_MASK);
+        __m256i const one = _mm256_set1_epi64x(1);
+        __m256i const zero = _mm256_setzero_si256();
+
+        __m256i src1bits = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(&src1[index]));
+        __m256i src2bits = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(&src2[index]));
+
+        __m256i exp1 = _mm256_srli_epi64(_mm256_and_si256(src1bits, expmask), FP64_EXPONENT_SHIFT);
+        __m256i exp2 = _mm256_srli_epi64(_mm256_and_si256(src2bits, expmask), FP64_EXPONENT_SHIFT);
+        __m256i dexp = _mm256_sub_epi64(exp1, exp2);
+        __m256i special = _mm256_or_si256(_mm256_or_si256(slowpath_fp64_x4(src1bits), slowpath_fp64_x4(src2bits)),
+            _mm256_or_si256(_mm256_cmpgt_epi64(dexp, _mm256_set1_epi64x(63)), _mm256_cmpgt_epi64(_mm256_set1_epi64x(64), exp2)));
+        __m256i a = _mm256_or_si256(_mm256_and_si256(src1bits, mantmask), implicit_one);
+        __m256i b = _mm256_or_si256(_mm256_and_si256(src2bits, mantmask), implicit_one);
+
+        // first quotient bit, then up to 26 more per step for lanes that
+        // need them; the double-precision estimate of each chunk is never low
+        // and at most one high, and the low 64 bits of the new remainder are
+        // enough to detect and correct that
+        __m256i less = _mm256_cmpgt_epi64(b, a);
+        __m256i rem = _mm256_sub_epi64(a, _mm256_andnot_si256(less, b));
+        __m256i q = _mm256_andnot_si256(less, one);
+        __m256d bd = cvtepu64_pd_x4(b);
+        __m256i left = _mm256_andnot_si256(special, _mm256_and_si256(dexp, _mm256_cmpgt_epi64(dexp, zero)));
+        while (!_mm256_testz_si256(left, left))
+        {
+            __m256i bits = _mm256_blendv_epi8(left, _mm256_set1_epi64x(26), _mm256_cmpgt_epi64(left, _mm256_set1_epi64x(26)));
+            __m256d scale = _mm256_castsi256_pd(_mm256_slli_epi64(_mm256_add_epi64(bits, _mm256_set1_epi64x(FP64_EXPONENT_BIAS)), FP64_EXPONENT_SHIFT));
+            __m256d estimate = _mm256_div_pd(_mm256_mul_pd(cvtepu64_pd_x4(rem), scale), bd);
+            __m256i qchunk = _mm256_cvtepi32_epi64(_mm256_cvttpd_epi32(estimate));
+            __m256i product = _mm256_add_epi64(_mm256_mul_epu32(qchunk, b), _mm256_slli_epi64(_mm256_mul_epu32(qchunk, _mm256_srli_epi64(b, 32)), 32));
+            __m256i nextrem = _mm256_sub_epi64(_mm256_sllv_epi64(rem, bits), product);
+            __m256i high = _mm256_cmpgt_epi64(zero, nextrem);
+            nextrem = _mm256_add_epi64(nextrem, _mm256_and_si256(high, b));
+            qchunk = _mm256_add_epi64(qchunk, high);
+            __m256i active = _mm256_cmpgt_epi64(left, zero);
+            rem = _mm256_blendv_epi8(rem, nextrem, active);
+            q = _mm256_blendv_epi8(q, _mm256_add_epi64(_mm256_sllv_epi64(q, bits), qchunk), active);
+            left = _mm256_sub_epi64(left, bits);
+        }
+
+        // express the remainder in units of half an ulp of src2; when src2
+        // is one binade above src1, the quotient is 0 and src1 is the remainder
+        __m256i below = _mm256_cmpeq_epi64(dexp, _mm256_set1_epi64x(-1));
+        rem = _mm256_blendv_epi8(_mm256_slli_epi64(rem, 1), a, below);
+        q = _mm256_andnot_si256(below, q);
+        __m256i sign = _mm256_and_si256(src1bits, signmask);
+
+        // fprem1 rounds the quotient to nearest-even instead of truncating
+        if constexpr (Rem1)
+        {
+            __m256i adjust = _mm256_or_si256(_mm256_cmpgt_epi64(rem, b), _mm256_and_si256(_mm256_cmpeq_epi64(rem, b), _mm256_cmpeq_epi64(_mm256_and_si256(q, one), one)));
+            rem = _mm256_blendv_epi8(rem, _mm256_sub_epi64(_mm256_slli_epi64(b, 1), rem), adjust);
+            q = _mm256_sub_epi64(q, adjust);
+            sign = _mm256_xor_si256(sign, _mm256_and_si256(adjust, signmask));
+        }
+
+        // the remainder has at most 53 significant bits, so both the conversion
+        // and the power-of-two scale are exact
+        __m256d scale = _mm256_castsi256_pd(_mm256_slli_epi64(_mm256_sub_epi64(exp2, _mm256_set1_epi64x(FP64_MANTISSA_BITS + 1)), FP64_EXPONENT_SHIFT));
+        __m256i resbits = _mm256_or_si256(_mm256_castpd_si256(_mm256_mul_pd(cvtepu64_pd_x4(rem), scale)), sign);
+
+        // quotient bits 0-2 go to C1, C3, and C0
+        __m256i cc = _mm256_slli_epi64(_mm256_and_si256(q, one), X87SW_C1_BIT);
+        cc = _mm256_or_si256(cc, _mm256_slli_epi64(_mm256_and_si256(q, _mm256_set1_epi64x(2)), X87SW_C3_BIT - 1));
+        cc = _mm256_or_si256(cc, _mm256_slli_epi64(_mm256_and_si256(q, _mm256_set1_epi64x(4)), X87SW_C0_BIT - 2));
+
+        // if src1 is more than a binade below src2, it is returned unchanged
+        __m256i tiny = _mm256_cmpgt_epi64(_mm256_set1_epi64x(-1), dexp);
+        resbits = _mm256_blendv_epi8(resbits, src1bits, tiny);
+        cc = _mm256_andnot_si256(tiny, cc);
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(&dst[index]), resbits);
+        flags = _mm256_or_si256(flags, _mm256_andnot_si256(special, cc));
+
+        return special;
+    }
+#endif
+};
+
+//
+// entry points; the quotient bits in C0/C1/C3 are ORed across elements like
+// any other flag, so C2 (some remainder is only partial) is the useful one
+//
+uint16_t fp64_t::x87_fprem_batch(fp64_t const *src1, fp64_t const *src2, fp64_t *dst, size_t count)
+{
+    return run_batch<fprem_batch_kernel<false>>(count, src1, src2, dst);
+}
+
+uint16_t fp64_t::x87_fprem1_batch(fp64_t const *src1, fp64_t const *src2, fp64_t *dst, size_t count)
+{
+    return run_batch<fprem_batch_kernel<true>>(count, src1, src2, dst);
+}
+
+
 
 //===========================================================================
 //
@@ -633,11 +1168,94 @@ uint16_t fp64_t::x87_fprem1(fp64_t const &src1, fp64_t const &src2, fp64_t &dst)
 //        64332 matches [99.98%]
 //           10 off by 1 bits [0.02%]
 //
+// Doing w, h and g in fpext80_t gives the same results as fpext96_t, which
+// fix about 13% of the remaining off-by-1 results at about 1.6x the cost;
+// fpext64_t is kept so the scalar and 4-lane versions stay bit-identical.
+//
+// The table size is set by X87_F2XM1_LOG_R. Larger tables shrink w, which
+// both cuts Taylor terms and reduces the error of the double-precision
+// series; against hardware over 2M random inputs, scalar latencies:
+//   R=16:  1213 off by 1,  9 terms, 70-80 ns warm, 550-600 ns cold
+//   R=64:   597 off by 1,  7 terms, 70 ns warm, 590-640 ns cold
+//   R=256:  546 off by 1,  6 terms, 68-82 ns warm, 640-920 ns cold
+//
 //===========================================================================
 
-template<bool Debug>
+//
+// number of Taylor terms N needed for R table steps per unit. x is rounded
+// to the nearest multiple of 1/R, so |v| <= 1/(2R) = 2^-(LOG_R+1) and
+// |w| = |v|*ln(2) <= ln(2)/(2R). The series stops at w^N/N!, so the
+// truncation error is the tail w^(N+1)/(N+1)! * (1 + w/(N+2) + ...), which
+// is at most w^(N+1)/(N+1)! / (1 - w/(N+2)); relative to the result, which
+// is about w, that is w^N/(N+1)! / (1 - w/(N+2)). N is the smallest count
+// keeping this below half an ulp of the 64-bit mantissa, 2^-64, so the
+// bound holds for any LOG_R: R=16 needs 9 terms, R=32 8, R=64 and R=128 7,
+// and R=256 6; getting down to 4 terms would take R >= 8192 (LOG_R=13)
+//
+static constexpr int f2xm1_taylor_terms(int r)
+{
+    double const w = 0.693147180559945309 / (2 * r);
+    for (int terms = 2; ; terms++)
+    {
+        double bound = 1.0;
+        for (int power = 1; power <= terms; power++)
+            bound *= w;
+        for (int factor = 2; factor <= terms + 1; factor++)
+            bound /= factor;
+        bound /= 1.0 - w / (terms + 2);
+        if (bound <= 0x1p-64)
+            return terms;
+    }
+}
+
+//
+// n * (n-1) * ... for count factors, for the Taylor coefficients
+//
+static constexpr double f2xm1_falling_factorial(int n, int count)
+{
+    double product = 1.0;
+    for (int factor = 0; factor < count; factor++)
+        product *= n - factor;
+    return product;
+}
+
+//
+// constants and tables for a table of R = 2^LogR steps per unit, shared by
+// the scalar and batch versions; R=16 needs 9 Taylor terms, R=64 needs 7,
+// and R=256 needs 6
+//
+template<int LogR>
+struct f2xm1_tables
+{
+    static constexpr int LOG_R = LogR;
+    static constexpr int R = 1 << LogR;
+    static constexpr int TABLE_SIZE = 2 * R + 1;
+    static constexpr int TAYLOR_TERMS = f2xm1_taylor_terms(R);
+
+    // 2^(k/R) - 1
+    static constexpr fpext_table_t g = exp2m1_table<fpext64_t, R>();
+
+    // k/R
+    static constexpr auto u = []<size_t... Index>(std::index_sequence<Index...>)
+    {
+        return std::array<fp64_t, TABLE_SIZE>{ fp64_t(double(int(Index) - R) / double(R))... };
+    }(std::make_index_sequence<TABLE_SIZE>());
+
+    // N, N*(N-1), ..., N!/2
+    static constexpr auto taylor_coeff = []<size_t... Index>(std::index_sequence<Index...>)
+    {
+        return std::array<fpext52_t, TAYLOR_TERMS - 2>{ fpext52_t(f2xm1_falling_factorial(TAYLOR_TERMS, Index + 1))... };
+    }(std::make_index_sequence<TAYLOR_TERMS - 2>());
+
+    // 1/N!
+    static constexpr fp64_t taylor_factorial_inv = fp64_t(1.0 / f2xm1_falling_factorial(TAYLOR_TERMS, TAYLOR_TERMS));
+};
+
+template<int LogR, bool Debug>
 static uint16_t x87_f2xm1_core(fp64_t const &src, fp64_t &dst)
 {
+    using tables = f2xm1_tables<LogR>;
+
     // special case values outside of defined range
     auto exponent = src.exponent();
     if (exponent >= 0)
@@ -648,106 +1266,16 @@ static uint16_t x87_f2xm1_core(fp64_t const &src, fp64_t &dst)
     if (exponent <= -1000)
         goto tiny;
 
-    static const int LOG_R = 4;
-    static const int R = 1 << LOG_R;
-    static const int TABLE_SIZE = 2 * R + 1;
-    static const int TAYLOR_TERMS = 8;
-
-    static std::array<fpext64_t, TABLE_SIZE> const s_table_g =
-    {
-        fpext64_t(0x8000000000000000ull, 0x00000000, -1, 1),    // 2^(-16/16) = -0.5l,
-        fpext64_t(0xf4aa7930676f09d6ull, 0x746d48e8, -2, 1),    // 2^(-15/16) = -0.47786310878629307983901676063004l,
-        fpext64_t(0xe8d47c382ae85232ull, 0x08373af1, -2, 1),    // 2^(-14/16) = -0.45474613366737117039649467211965l,
-        fpext64_t(0xdc785918a9dc7993ull, 0xe0524e3f, -2, 1),    // 2^(-13/16) = -0.43060568262165417314808485807924l,
-        fpext64_t(0xcf901f5ce48ead21ull, 0x72a5b9d0, -2, 1),    // 2^(-12/16) = -0.40539644249863946664125001471976l,
-        fpext64_t(0xc2159b3edcbddca4ull, 0xbeddc1ec, -2, 1),    // 2^(-11/16) = -0.3790710939632579757031612656367l,
-        fpext64_t(0xb40252ac9d5d8e2bull, 0xc685013c, -2, 1),    // 2^(-10/16) = -0.35158022267449516703312294110377l,
-        fpext64_t(0xa54f822b7abd6a73ull, 0x6cfeae6e, -2, 1),    // 2^( -9/16) = -0.32287222653155363585099262992965l,
-        fpext64_t(0x95f619980c4336f7ull, 0x4d04ec99, -2, 1),    // 2^( -8/16) = -0.29289321881345247559915563789515l,
-        fpext64_t(0x85eeb8c14fe79282ull, 0xaefdc093, -2, 1),    // 2^( -7/16) = -0.26158692703025034430654625981298l,
-        fpext64_t(0xea6357baabe4948bull, 0x0754bcda, -3, 1),    // 2^( -6/16) = -0.22889458729602958819385406895463l,
-        fpext64_t(0xc76dcfab81edfc70ull, 0x7729f1c2, -3, 1),    // 2^( -5/16) = -0.1947548340253728459102396663213l,
-        fpext64_t(0xa2ec0cd4a58a542full, 0x1965d11a, -3, 1),    // 2^( -4/16) = -0.15910358474628545696887452376679l,
-        fpext64_t(0xf999089eab58f777ull, 0xcd3b57dc, -4, 1),    // 2^( -3/16) = -0.12187391981335025844391969031234l,
-        fpext64_t(0xa9f9c8c116de3689ull, 0x7e945264, -4, 1),    // 2^( -2/16) = -0.08299595679532876825645840520586l,
-        fpext64_t(0xada82eadb7933d38ull, 0x462f3851, -5, 1),    // 2^( -1/16) = -0.04239671930142635306369436485208l,
-        fpext64_t(0x0000000000000000ull, 0x00000000, fpext96_t::EXPONENT_MIN, 0), // 0
-        fpext64_t(0xb5586cf9890f6298ull, 0xb92b7184, -5, 0),    // 2^( +1/16) = 0.04427378242741384032196647873993l,
-        fpext64_t(0xb95c1e3ea8bd6e6full, 0xbe462876, -4, 0),    // 2^( +2/16) = 0.09050773266525765920701065576071l,
-        fpext64_t(0x8e1e9b9d588e19b0ull, 0x7eb6c705, -3, 0),    // 2^( +3/16) = 0.13878863475669165370383028384151l,
-        fpext64_t(0xc1bf828c6dc54b7aull, 0x356918c1, -3, 0),    // 2^( +4/16) = 0.18920711500272106671749997056048l,
-        fpext64_t(0xf7a993048d088d6dull, 0x0488f84f, -3, 0),    // 2^( +5/16) = 0.2418578120734840485936774687266l,
-        fpext64_t(0x97fb5aa6c544e3a8ull, 0x72f5fd88, -2, 0),    // 2^( +6/16) = 0.29683955465100966593375411779245l,
-        fpext64_t(0xb560fba90a852b19ull, 0x2602a324, -2, 0),    // 2^( +7/16) = 0.3542555469368927282980147401407l,
-        fpext64_t(0xd413cccfe7799211ull, 0x65f626ce, -2, 0),    // 2^( +8/16) = 0.4142135623730950488016887242097l,
-        fpext64_t(0xf4228e7d6030dafaull, 0xa2047eda, -2, 0),    // 2^( +9/16) = 0.47682614593949931138690748037405l,
-        fpext64_t(0x8ace5422aa0db5baull, 0x7c55a193, -1, 0),    // 2^(+10/16) = 0.54221082540794082361229186209073l,
-        fpext64_t(0x9c49182a3f0901c7ull, 0xc46b071f, -1, 0),    // 2^(+11/16) = 0.6104903319492543081795206673574l,
-        fpext64_t(0xae89f995ad3ad5e8ull, 0x734d1773, -1, 0),    // 2^(+12/16) = 0.68179283050742908606225095246643l,
-        fpext64_t(0xc199bdd85529c222ull, 0x0cb12a09, -1, 0),    // 2^(+13/16) = 0.75625216037329948311216061937531l,
-        fpext64_t(0xd5818dcfba48725dull, 0xa05aeb67, -1, 0),    // 2^(+14/16) = 0.83400808640934246348708318958829l,
-        fpext64_t(0xea4afa2a490d9858ull, 0xf73a18f6, -1, 0),    // 2^(+15/16) = 0.91520656139714729387261127029583l,
-        fpext64_t(0x8000000000000000ull, 0x00000000,  0, 0)     // 2^(+16/16) = 1.0
-    };
-    static std::array<fp64_t, TABLE_SIZE> const s_table_u =
-    {
-        -16.0/16.0,
-        -15.0/16.0,
-        -14.0/16.0,
-        -13.0/16.0,
-        -12.0/16.0,
-        -11.0/16.0,
-        -10.0/16.0,
-         -9.0/16.0,
-         -8.0/16.0,
-         -7.0/16.0,
-         -6.0/16.0,
-         -5.0/16.0,
-         -4.0/16.0,
-         -3.0/16.0,
-         -2.0/16.0,
-         -1.0/16.0,
-          0.0/16.0,
-          1.0/16.0,
-          2.0/16.0,
-          3.0/16.0,
-          4.0/16.0,
-          5.0/16.0,
-          6.0/16.0,
-          7.0/16.0,
-          8.0/16.0,
-          9.0/16.0,
-         10.0/16.0,
-         11.0/16.0,
-         12.0/16.0,
-         13.0/16.0,
-         14.0/16.0,
-         15.0/16.0,
-         16.0/16.0
-    };
-    static std::array<fp64_t, TAYLOR_TERMS - 1> const s_taylor_coeff =
-    {
-        8.0,
-        8.0*7,
-        8.0*7*6,
-        8.0*7*6*5,
-        8.0*7*6*5*4,
-        8.0*7*6*5*4*3,
-        8.0*7*6*5*4*3*2
-    };
-    static fp64_t const s_taylor_factorial_inv =
-        1.0 / fp64_t(8*7*6*5*4*3*2);  // 1.0/8!
-
     {
         // round x to the nearest multiple of 1/R by looking at the high bits of the mantissa
         int32_t g_index = 0;
 
         // anything smaller than -LOG_R - 1 will round to 0, so only do this if above
-        if (exponent >= -LOG_R - 1)
+        if (exponent >= -tables::LOG_R - 1)
         {
             // shift mantissa down (after adding explicit 1) so we just have LOG_R + 1 bits
             auto mantissa = src.mantissa() | (FP64_MANTISSA_MASK + 1);
-            g_index = int32_t(mantissa >> (FP64_EXPONENT_SHIFT - LOG_R - exponent - 1));
+            g_index = int32_t(mantissa >> (FP64_EXPONENT_SHIFT - tables::LOG_R - exponent - 1));
 
             // round by adding LSB and shifting to get LOG_R bits
             g_index = (g_index >> 1) + (g_index & 1);
@@ -758,31 +1286,25 @@ static uint16_t x87_f2xm1_core(fp64_t const &src, fp64_t &dst)
         }
 
         // compute v = delta from table entry
-        fp64_t v = src - s_table_u[g_index + R];
+        fp64_t v = src - tables::u[g_index + tables::R];
 
         // multiply v by ln(2) so we can use the e^x Taylor series; do this in
         // extended precision
         fpext64_t w = fpext64_t(v) * fpext64_t::ln2;
         if (Debug) print_val("w", w);
 
-        // Taylor series: this can be done in lower precision; start with h = w + coeff[0]
+        // Taylor series: this can be done in lower precision; Estrin was
+        // slower here than the unrolled Horner steps, and less accurate
         fp64_t w64 = w.as_fp64();
-        fp64_t h64 = w64 + s_taylor_coeff[0];
-        if (Debug) print_val("h1", h64);
-
-        // now compute h = h * w + coeff[term] for terms up through 7
-        for (int term = 1; term < TAYLOR_TERMS - 2; term++)
-        {
-            h64 = h64 * w64 + s_taylor_coeff[term];
-            if (Debug) print_val("hn", h64);
-        }
+        fp64_t h64 = poly1_eval_unrolled<tables::taylor_coeff>(fpext52_t(w64)).as_fp64();
+        if (Debug) print_val("hn", h64);
 
         // final term is just times w^2
         h64 *= w64 * w64;
         if (Debug) print_val("h2", h64);
 
-        // then divide by 9!
-        h64 = h64 * s_taylor_factorial_inv;
+        // then divide by N!
+        h64 = h64 * tables::taylor_factorial_inv;
 
         // back to extended precision for final result; add w for final h value
         fpext64_t h(h64);
@@ -790,7 +1312,7 @@ static uint16_t x87_f2xm1_core(fp64_t const &src, fp64_t &dst)
         if (Debug) print_val("h3", h);
 
         // retrieve g from the table
-        fpext64_t g = s_table_g[g_index + R];
+        fpext64_t g = tables::g[g_index + tables::R];
         if (Debug) print_val("g", g);
 
         // return g * h + g + h
@@ -850,7 +1372,91 @@ tiny:
 
 uint16_t fp64_t::x87_f2xm1(fp64_t const &src, fp64_t &dst)
 {
-    return x87_f2xm1_core<false>(src, dst);
+    return x87_f2xm1_core<X87_F2XM1_LOG_R, false>(src, dst);
+}
+
+
+
+//
+// batch kernel
+//
+template<int LogR>
+struct f2xm1_batch_kernel
+{
+    using tables = f2xm1_tables<LogR>;
+
+    //
+    // scalar version
+    //
+    static uint16_t scalar(size_t index, fp64_t const *src, fp64_t *dst)
+    {
+        return x87_f2xm1_core<LogR, false>(src[index], dst[index]);
+    }
+
+#if X87_SIMD_X64
+    //
+    // AVX2 version: the table index, the gathers from the U and G tables, the
+    // Taylor series, and the extended-precision steps (via fpext64x4_t) all run
+    // across 4 lanes. Values outside the table range (|x| >= 1, tiny values,
+    // zeros, denormals, infinities, NaNs) are redone by the scalar code. Only
+    // AVX2 is used because allowing AVX-512 would also allow FMA contraction,
+    // which would change the results
+    //
+    X87_TARGET_AVX2 static __m256i avx2(size_t index, __m256i &flags, fp64_t const *src, fp64_t *dst)
+    {
+        __m256i const one = _mm256_set1_epi64x(1);
+        __m256i const center = _mm256_set1_epi64x(tables::R);
+        fpext64x4_t const ln2(fpext64_t::ln2);
+
+        __m256i srcbits = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(&src[index]));
+        __m256d srcval = _mm256_castsi256_pd(srcbits);
+
+        // exponents >= 0 and <= -1000 are special, same as the scalar code
+        __m256i exponent = _mm256_sub_epi64(_mm256_srli_epi64(_mm256_and_si256(srcbits, _mm256_set1_epi64x(FP64_EXPONENT_MASK)), FP64_EXPONENT_SHIFT), _mm256_set1_epi64x(FP64_EXPONENT_BIAS));
+        __m256i special = _mm256_or_si256(_mm256_cmpgt_epi64(exponent, _mm256_set1_epi64x(-1)), _mm256_cmpgt_epi64(_mm256_set1_epi64x(-999), exponent));
+
+        // round x to the nearest multiple of 1/R; exponents below -LOG_R - 1
+        // shift everything out and produce an index of 0 naturally
+        __m256i mantissa = _mm256_or_si256(_mm256_and_si256(srcbits, _mm256_set1_epi64x(FP64_MANTISSA_MASK)), _mm256_set1_epi64x(FP64_MANTISSA_MASK + 1));
+        __m256i g_index = _mm256_srlv_epi64(mantissa, _mm256_sub_epi64(_mm256_set1_epi64x(FP64_EXPONENT_SHIFT - tables::LOG_R - 1), exponent));
+        g_index = _mm256_add_epi64(_mm256_srli_epi64(g_index, 1), _mm256_and_si256(g_index, one));
+        __m256i negative = _mm256_cmpgt_epi64(_mm256_setzero_si256(), srcbits);
+        g_index = _mm256_sub_epi64(_mm256_xor_si256(g_index, negative), negative);
+
+        // special lanes may have produced anything, so keep their gathers in range
+        __m256i table_index = _mm256_blendv_epi8(_mm256_add_epi64(g_index, center), center, special);
+
+        // compute v = delta from table entry, and w = v * ln(2) in extended precision
+        __m256d v = _mm256_sub_pd(srcval, _mm256_i64gather_pd(reinterpret_cast<double const *>(tables::u.data()), table_index, 8));
+        fpext64x4_t w = fpext64x4_t::mul(fpext64x4_t(v), ln2);
+
+        // Taylor series in lower precision
+        __m256d w64 = w.as_fp64();
+        __m256d h64 = poly1_eval_x4(w64, tables::taylor_coeff);
+        h64 = _mm256_mul_pd(h64, _mm256_mul_pd(w64, w64));
+        h64 = _mm256_mul_pd(h64, _mm256_set1_pd(tables::taylor_factorial_inv.as_double()));
+
+        // back to extended precision; add w for final h value
+        fpext64x4_t h = fpext64x4_t::add(fpext64x4_t(h64), w);
+
+        // retrieve g from the table
+        fpext64x4_t g(tables::g, table_index);
+
+        // result is g * h + g + h
+        __m256d result = fpext64x4_t::add(fpext64x4_t::add(fpext64x4_t::mul(g, h), g), h).as_fp64();
+        _mm256_storeu_pd(reinterpret_cast<double *>(&dst[index]), result);
+
+        // every non-special lane is inexact
+        flags = _mm256_or_si256(flags, _mm256_andnot_si256(special, _mm256_set1_epi64x(X87SW_PRECISION_EX)));
+
+        return special;
+    }
+#endif
+};
+
+uint16_t fp64_t::x87_f2xm1_batch(fp64_t const *src, fp64_t *dst, size_t count)
+{
+    return run_batch<f2xm1_batch_kernel<X87_F2XM1_LOG_R>>(count, src, dst);
 }
 
 
@@ -869,6 +1475,30 @@ uint16_t fp64_t::x87_f2xm1(fp64_t const &src, fp64_t &dst)
 //
 //===========================================================================
 
+//
+// constants, shared by the scalar and batch versions of fyl2x and fyl2xp1
+//
+static constexpr fp64_t s_log_two54 = fp64_t::from_fpbits64(0x4350000000000000ull);      // 1.80143985094819840000e+16;
+static constexpr fp64_t s_log_ln2_hi = fp64_t::from_fpbits64(0x3fe62e42fee00000ull);     // 6.93147180369123816490e-01;
+static constexpr fp64_t s_log_ln2_lo = fp64_t::from_fpbits64(0x3dea39ef35793c76ull);     // 1.90821492927058770002e-10;
+static constexpr std::array<fp64_t, 8> s_log_lg =
+{
+    fp64_t::from_fpbits64(0x0000000000000000ull),    // 0.0,
+    fp64_t::from_fpbits64(0x3FE5555555555593ull),    // 6.666666666666735130e-01,
+    fp64_t::from_fpbits64(0x3FD999999997FA04ull),    // 3.999999999940941908e-01,
+    fp64_t::from_fpbits64(0x3FD2492494229359ull),    // 2.857142874366239149e-01,
+    fp64_t::from_fpbits64(0x3FCC71C51D8E78AFull),    // 2.222219843214978396e-01,
+    fp64_t::from_fpbits64(0x3FC7466496CB03DEull),    // 1.818357216161805012e-01,
+    fp64_t::from_fpbits64(0x3FC39A09D078C69Full),    // 1.531383769920937332e-01,
+    fp64_t::from_fpbits64(0x3FC2F112DF3E5244ull),    // 1.479819860511658591e-01
+};
+
+// the even and odd terms above in descending order, for fyl2x
+static constexpr std::array<fpext52_t, 3> s_log_lg_even = { fpext52_t(s_log_lg[6]), fpext52_t(s_log_lg[4]), fpext52_t(s_log_lg[2]) };
+static constexpr std::array<fpext52_t, 4> s_log_lg_odd = { fpext52_t(s_log_lg[7]), fpext52_t(s_log_lg[5]), fpext52_t(s_log_lg[3]), fpext52_t(s_log_lg[1]) };
+
+static constexpr fpext64_t s_log_invln2(0xb8aa3b295c17f0bbull, 0xbe87fed0,  0, 0);
+
 uint16_t fp64_t::x87_fyl2x(fp64_t const &src1, fp64_t const &src2, fp64_t &dst)
 {
     // denorm flag is set regardless
@@ -895,24 +1525,17 @@ uint16_t fp64_t::x87_fyl2x(fp64_t const &src1, fp64_t const &src2, fp64_t &dst)
         goto times0;
 
     {
-        static const fp64_t two54 = fp64_t::from_fpbits64(0x4350000000000000ull); //1.80143985094819840000e+16;
-        static const fp64_t Lg1   = fp64_t::from_fpbits64(0x3FE5555555555593ull); //6.666666666666735130e-01;
-        static const fp64_t Lg2   = fp64_t::from_fpbits64(0x3FD999999997FA04ull); //3.999999999940941908e-01;
-        static const fp64_t Lg3   = fp64_t::from_fpbits64(0x3FD2492494229359ull); //2.857142874366239149e-01;
-        static const fp64_t Lg4   = fp64_t::from_fpbits64(0x3FCC71C51D8E78AFull); //2.222219843214978396e-01;
-        static const fp64_t Lg5   = fp64_t::from_fpbits64(0x3FC7466496CB03DEull); //1.818357216161805012e-01;
-        static const fp64_t Lg6   = fp64_t::from_fpbits64(0x3FC39A09D078C69Full); //1.531383769920937332e-01;
-        static const fp64_t Lg7   = fp64_t::from_fpbits64(0x3FC2F112DF3E5244ull); //1.479819860511658591e-01;
-
         // accuracy/speed results:
         //   fpext52_t: 125778632(0) / 37316356(1) / 2898(2) / 16(3) / 10(4) / 6(5) / 10295(exp), 0.11 ticks
         //   fpext64_t: 162919171(0) / 186112(1), 0.23 ticks
         //   fpext96_t: 162934641(0) / 170642(1), 0.32 ticks
+        // against hardware in 53-bit chop mode, 2M random inputs:
+        //   fpext64_t:  1982223(0) / 17777(1) / 0(2)
+        //   fpext106_t: 1982222(0) / 17778(1) / 0(2), about 2x faster with hardware FMA
         using fpext_t = fpext64_t;
 
-        static fpext_t const invln2(0xb8aa3b295c17f0bbull, 0xbe87fed0,  0, 0);
         fpext_t src280(src2);
-        fpext_t src2invln2 = src280 * invln2;
+        fpext_t src2invln2 = src280 * fpext_t(s_log_invln2);
 
         if (src1 != fp64_t::const_one())
             flags |= X87SW_PRECISION_EX;
@@ -926,7 +1549,7 @@ uint16_t fp64_t::x87_fyl2x(fp64_t const &src1, fp64_t const &src2, fp64_t &dst)
         if (x.isdenorm())
         {
             k -= 54;
-            x *= two54;
+            x *= s_log_two54;
             rawsrc = x.as_fpbits64();
             hx = int32_t(rawsrc >> 32);
         }
@@ -954,8 +1577,10 @@ uint16_t fp64_t::x87_fyl2x(fp64_t const &src1, fp64_t const &src2, fp64_t &dst)
         i = hx - IC(0x6147a);
         fp64_t w = z * z;
         int32_t j = IC(0x6b851) - hx;
-        fp64_t t1 = w * (Lg2 + w * (Lg4 + w * Lg6));
-        fp64_t t2 = z * (Lg1 + w * (Lg3 + w * (Lg5 + w * Lg7)));
+        // the even/odd split already gives two independent chains; a full
+        // Estrin over z was slower
+        fp64_t t1 = w * poly_eval_unrolled<s_log_lg_even>(fpext52_t(w)).as_fp64();
+        fp64_t t2 = z * poly_eval_unrolled<s_log_lg_odd>(fpext52_t(w)).as_fp64();
         i |= j;
         fp64_t R = t2 + t1;
         if (i > 0)
@@ -1004,6 +1629,94 @@ invalid:
 }
 
 
+//
+// batch kernel
+//
+struct fyl2x_batch_kernel
+{
+    //
+    // scalar version
+    //
+    static uint16_t scalar(size_t index, fp64_t const *src1, fp64_t const *src2, fp64_t *dst)
+    {
+        return fp64_t::x87_fyl2x(src1[index], src2[index], dst[index]);
+    }
+
+#if X87_SIMD_X64
+    //
+    // AVX2 version: the polynomial runs across 4 lanes, and the range checks on
+    // hx, the small |f| shortcut, and the choice of final expression are done
+    // with masks and blends. Negative, zero, denormal, infinite, and NaN inputs
+    // are redone by the scalar code. Only AVX2 is used because allowing AVX-512
+    // would also allow FMA contraction, which would change the results
+    //
+    X87_TARGET_AVX2 static __m256i avx2(size_t index, __m256i &flags, fp64_t const *src1, fp64_t const *src2, fp64_t *dst)
+    {
+        __m256i const expmask = _mm256_set1_epi64x(FP64_EXPONENT_MASK);
+        __m256i const hxmask = _mm256_set1_epi64x(0x000fffff);
+        __m256d const one = _mm256_set1_pd(1.0);
+        fpext64x4_t const invln2(s_log_invln2);
+
+        __m256i src1bits = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(&src1[index]));
+        __m256i src2bits = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(&src2[index]));
+
+        // src1 must be positive and normal, src2 must be normal
+        __m256i exp1 = _mm256_and_si256(src1bits, expmask);
+        __m256i special = _mm256_or_si256(_mm256_cmpgt_epi64(_mm256_setzero_si256(), src1bits),
+            _mm256_or_si256(slowpath_fp64_x4(src1bits), slowpath_fp64_x4(src2bits)));
+
+        fpext64x4_t src280(_mm256_castsi256_pd(src2bits));
+        fpext64x4_t src2invln2 = fpext64x4_t::mul(src280, invln2);
+
+        // split into k and x in [sqrt(2)/2, sqrt(2)]
+        __m256i hx = _mm256_and_si256(_mm256_srli_epi64(src1bits, 32), hxmask);
+        __m256i i = _mm256_and_si256(_mm256_add_epi64(hx, _mm256_set1_epi64x(0x95f64)), _mm256_set1_epi64x(0x100000));
+        __m256d x = _mm256_castsi256_pd(_mm256_or_si256(_mm256_and_si256(src1bits, _mm256_set1_epi64x(FP64_MANTISSA_MASK)),
+            _mm256_slli_epi64(_mm256_xor_si256(i, _mm256_set1_epi64x(0x3ff00000)), 32)));
+        __m256i k = _mm256_add_epi64(_mm256_sub_epi64(_mm256_srli_epi64(exp1, FP64_EXPONENT_SHIFT), _mm256_set1_epi64x(FP64_EXPONENT_BIAS)), _mm256_srli_epi64(i, 20));
+        fpext64x4_t dk80 = fpext64x4_t::mul(fpext64x4_t(cvtepi64_pd_small_x4(k)), src280);
+        __m256d f = _mm256_sub_pd(x, one);
+
+        // main polynomial
+        __m256d s = _mm256_div_pd(f, _mm256_add_pd(_mm256_set1_pd(2.0), f));
+        __m256d z = _mm256_mul_pd(s, s);
+        __m256d w = _mm256_mul_pd(z, z);
+        __m256d t1 = _mm256_mul_pd(w, poly_eval_x4(w, s_log_lg_even));
+        __m256d t2 = _mm256_mul_pd(z, poly_eval_x4(w, s_log_lg_odd));
+        __m256d R = _mm256_add_pd(t2, t1);
+
+        // pick between the hfsq and non-hfsq forms
+        __m256i usehfsq = _mm256_cmpgt_epi64(_mm256_or_si256(_mm256_sub_epi64(hx, _mm256_set1_epi64x(0x6147a)), _mm256_sub_epi64(_mm256_set1_epi64x(0x6b851), hx)), _mm256_setzero_si256());
+        __m256d hfsq = _mm256_mul_pd(_mm256_mul_pd(_mm256_set1_pd(0.5), f), f);
+        __m256d term = _mm256_blendv_pd(_mm256_sub_pd(_mm256_mul_pd(s, _mm256_sub_pd(f, R)), f),
+            _mm256_sub_pd(_mm256_sub_pd(hfsq, _mm256_mul_pd(s, _mm256_add_pd(hfsq, R))), f), _mm256_castsi256_pd(usehfsq));
+
+        // |f| < 2**-20 uses a shorter series
+        __m256i smallf = _mm256_cmpgt_epi64(_mm256_set1_epi64x(3), _mm256_and_si256(_mm256_add_epi64(hx, _mm256_set1_epi64x(2)), hxmask));
+        __m256d Rs = _mm256_mul_pd(_mm256_mul_pd(f, f), _mm256_sub_pd(_mm256_set1_pd(0.5), _mm256_mul_pd(_mm256_set1_pd(0.33333333333333333), f)));
+        term = _mm256_blendv_pd(term, _mm256_sub_pd(Rs, f), _mm256_castsi256_pd(smallf));
+
+        // compute the result; f == 0 just returns dk80
+        __m256d result = fpext64x4_t::sub(dk80, fpext64x4_t::mul(fpext64x4_t(term), src2invln2)).as_fp64();
+        __m256d fzero = _mm256_and_pd(_mm256_castsi256_pd(smallf), _mm256_cmp_pd(f, _mm256_setzero_pd(), _CMP_EQ_OQ));
+        result = _mm256_blendv_pd(result, dk80.as_fp64(), fzero);
+        _mm256_storeu_pd(reinterpret_cast<double *>(&dst[index]), result);
+
+        // everything but log2(1) is inexact
+        __m256i exact = _mm256_cmpeq_epi64(src1bits, _mm256_castpd_si256(one));
+        flags = _mm256_or_si256(flags, _mm256_andnot_si256(_mm256_or_si256(special, exact), _mm256_set1_epi64x(X87SW_PRECISION_EX)));
+
+        return special;
+    }
+#endif
+};
+
+uint16_t fp64_t::x87_fyl2x_batch(fp64_t const *src1, fp64_t const *src2, fp64_t *dst, size_t count)
+{
+    return run_batch<fyl2x_batch_kernel>(count, src1, src2, dst);
+}
+
+
 
 //===========================================================================
 //
@@ -1045,30 +1758,17 @@ uint16_t fp64_t::x87_fyl2xp1(fp64_t const &src1, fp64_t const &src2, fp64_t &dst
     if (src2.iszero())
         goto times0;
 
-    static const fp64_t ln2_hi = fp64_t::from_fpbits64(0x3fe62e42fee00000);     // 6.93147180369123816490e-01;
-    static const fp64_t ln2_lo = fp64_t::from_fpbits64(0x3dea39ef35793c76);     // 1.90821492927058770002e-10;
-    static const fp64_t two54 =  fp64_t::from_fpbits64(0x4350000000000000);     // 1.80143985094819840000e+16;
-    static const std::array<fp64_t, 8> Lp =
-    {
-        fp64_t::from_fpbits64(0x0000000000000000),    // 0.0,
-        fp64_t::from_fpbits64(0x3FE5555555555593),    // 6.666666666666735130e-01,
-        fp64_t::from_fpbits64(0x3FD999999997FA04),    // 3.999999999940941908e-01,
-        fp64_t::from_fpbits64(0x3FD2492494229359),    // 2.857142874366239149e-01,
-        fp64_t::from_fpbits64(0x3FCC71C51D8E78AF),    // 2.222219843214978396e-01,
-        fp64_t::from_fpbits64(0x3FC7466496CB03DE),    // 1.818357216161805012e-01,
-        fp64_t::from_fpbits64(0x3FC39A09D078C69F),    // 1.531383769920937332e-01,
-        fp64_t::from_fpbits64(0x3FC2F112DF3E5244),    // 1.479819860511658591e-01
-    };
-
     {
         // accuracy/speed results:
         //   fpext52_t: fails
         //   fpext64_t: 142794485(0) / 21488338(1) / 126(2), 0.18 ticks
         //   fpext96_t: 142802124(0) / 21480699(1) / 126(2), 0.30 ticks
+        // against hardware in 53-bit chop mode, 2M random inputs:
+        //   fpext64_t:  1477918(0) / 522063(1) / 19(2)
+        //   fpext106_t: 1477895(0) / 522086(1) / 19(2), about 1.7x faster with hardware FMA
         using fpext_t = fpext64_t;
 
-        static fpext_t const invln2(0xb8aa3b295c17f0bbull, 0xbe87fed0,  0, 0);
-        fpext_t src2invln2 = fpext_t(src2) * invln2;
+        fpext_t src2invln2 = fpext_t(src2) * fpext_t(s_log_invln2);
 
         if (!src1.iszero())
             flags |= X87SW_PRECISION_EX;
@@ -1137,8 +1837,8 @@ uint16_t fp64_t::x87_fyl2xp1(fp64_t const &src1, fp64_t const &src2, fp64_t &dst
                     dst = fp64_t::const_zero();
                 else
                 {
-                    c += k * ln2_lo;
-                    dst = (fpext_t(k * ln2_hi + c) * src2invln2).as_fp64();
+                    c += k * s_log_ln2_lo;
+                    dst = (fpext_t(k * s_log_ln2_hi + c) * src2invln2).as_fp64();
                 }
                 return flags;
             }
@@ -1146,23 +1846,23 @@ uint16_t fp64_t::x87_fyl2xp1(fp64_t const &src1, fp64_t const &src2, fp64_t &dst
             if (k == 0)
                 dst = (fpext_t(f - R) * src2invln2).as_fp64();
             else
-                dst = (fpext_t(k * ln2_hi - ((R - (k * ln2_lo + c)) - f)) * src2invln2).as_fp64();
+                dst = (fpext_t(k * s_log_ln2_hi - ((R - (k * s_log_ln2_lo + c)) - f)) * src2invln2).as_fp64();
             return flags;
         }
         fp64_t s = f / (2.0 + f);
         fp64_t z = s * s;
-        fp64_t R1 = z * Lp[1];
+        fp64_t R1 = z * s_log_lg[1];
         fp64_t z2 = z * z;
-        fp64_t R2 = Lp[2] + z * Lp[3];
+        fp64_t R2 = s_log_lg[2] + z * s_log_lg[3];
         fp64_t z4 = z2 * z2;
-        fp64_t R3 = Lp[4] + z * Lp[5];
+        fp64_t R3 = s_log_lg[4] + z * s_log_lg[5];
         fp64_t z6 = z4 * z2;
-        fp64_t R4 = Lp[6] + z * Lp[7];
+        fp64_t R4 = s_log_lg[6] + z * s_log_lg[7];
         fp64_t R = R1 + z2 * R2 + z4 * R3 + z6 * R4;
         if (k == 0)
             dst = (fpext_t(f - (hfsq - s * (hfsq + R))) * src2invln2).as_fp64();
         else
-            dst = (fpext_t(k * ln2_hi - ((hfsq - (s * (hfsq + R) + (k * ln2_lo + c))) - f)) * src2invln2).as_fp64();
+            dst = (fpext_t(k * s_log_ln2_hi - ((hfsq - (s * (hfsq + R) + (k * s_log_ln2_lo + c))) - f)) * src2invln2).as_fp64();
         return flags;
     }
 
@@ -1205,6 +1905,138 @@ oob:
 }
 
 
+//
+// batch kernel
+//
+struct fyl2xp1_batch_kernel
+{
+    //
+    // scalar version
+    //
+    static uint16_t scalar(size_t index, fp64_t const *src1, fp64_t const *src2, fp64_t *dst)
+    {
+        return fp64_t::x87_fyl2xp1(src1[index], src2[index], dst[index]);
+    }
+
+#if X87_SIMD_X64
+    //
+    // AVX2 version: all of the paths through the scalar code are evaluated
+    // across 4 lanes and the right one is selected per lane with blends.
+    // Values <= -1, denormals, infinities, NaNs, and zero multipliers are
+    // redone by the scalar code. Only AVX2 is used because allowing AVX-512
+    // would also allow FMA contraction, which would change the results; the
+    // scalar side depends on building without fp contraction (see
+    // x87common.h), since fusing any of its multiply-adds changes the last
+    // bit for some inputs
+    //
+    X87_TARGET_AVX2 static __m256i avx2(size_t index, __m256i &flags, fp64_t const *src1, fp64_t const *src2, fp64_t *dst)
+    {
+        __m256i const zeroi = _mm256_setzero_si256();
+        __m256d const zero = _mm256_setzero_pd();
+        __m256d const one = _mm256_set1_pd(1.0);
+        __m256d const ln2_hi = _mm256_set1_pd(s_log_ln2_hi.as_double());
+        __m256d const ln2_lo = _mm256_set1_pd(s_log_ln2_lo.as_double());
+        fpext64x4_t const invln2(s_log_invln2);
+
+        __m256i src1bits = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(&src1[index]));
+        __m256i src2bits = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(&src2[index]));
+        __m256d x = _mm256_castsi256_pd(src1bits);
+
+        // src1 must be > -1 and zero or normal, src2 must be normal
+        __m256i abs1 = _mm256_and_si256(src1bits, _mm256_set1_epi64x(FP64_ABS_MASK));
+        __m256i special = _mm256_or_si256(_mm256_castpd_si256(_mm256_cmp_pd(x, _mm256_set1_pd(-1.0), _CMP_LE_OQ)),
+            _mm256_or_si256(_mm256_andnot_si256(_mm256_cmpeq_epi64(abs1, zeroi), slowpath_fp64_x4(src1bits)), slowpath_fp64_x4(src2bits)));
+
+        fpext64x4_t src2invln2 = fpext64x4_t::mul(fpext64x4_t(_mm256_castsi256_pd(src2bits)), invln2);
+
+        // hx is the sign-extended upper word
+        __m256i hx = _mm256_sub_epi64(_mm256_xor_si256(_mm256_srli_epi64(src1bits, 32), _mm256_set1_epi64x(0x80000000)), _mm256_set1_epi64x(0x80000000));
+        __m256i ax = _mm256_srli_epi64(abs1, 32);
+
+        // |x| < 2**-29 and |x| < 2**-54 shortcuts
+        __m256i tiny = _mm256_cmpgt_epi64(_mm256_set1_epi64x(0x3e200000), ax);
+        __m256d tinyterm = _mm256_blendv_pd(_mm256_sub_pd(x, _mm256_mul_pd(_mm256_mul_pd(x, x), _mm256_set1_pd(0.5))), x,
+            _mm256_castsi256_pd(_mm256_cmpgt_epi64(_mm256_set1_epi64x(0x3c900000), ax)));
+
+        // -0.2929 < x < 0.41422 uses x directly with k = 0
+        __m256i kzero = _mm256_and_si256(_mm256_cmpgt_epi64(_mm256_set1_epi64x(0x3fda827a), hx),
+            _mm256_or_si256(_mm256_cmpgt_epi64(hx, zeroi), _mm256_cmpgt_epi64(_mm256_set1_epi64x(IC(0xbfd2bec3) + 1ll), hx)));
+
+        // otherwise compute u = 1 + x along with a correction term
+        __m256i bigx = _mm256_cmpgt_epi64(hx, _mm256_set1_epi64x(0x433fffff));
+        __m256d u = _mm256_blendv_pd(_mm256_add_pd(one, x), x, _mm256_castsi256_pd(bigx));
+        __m256i ubits = _mm256_castpd_si256(u);
+        __m256i hu = _mm256_and_si256(_mm256_srli_epi64(ubits, 32), _mm256_set1_epi64x(0x000fffff));
+        __m256i k = _mm256_sub_epi64(_mm256_srli_epi64(ubits, FP64_EXPONENT_SHIFT), _mm256_set1_epi64x(FP64_EXPONENT_BIAS));
+        __m256d c = _mm256_blendv_pd(_mm256_sub_pd(x, _mm256_sub_pd(u, one)), _mm256_sub_pd(one, _mm256_sub_pd(u, x)),
+            _mm256_castsi256_pd(_mm256_cmpgt_epi64(k, zeroi)));
+        c = _mm256_andnot_pd(_mm256_castsi256_pd(_mm256_or_si256(bigx, kzero)), _mm256_div_pd(c, u));
+
+        // normalize u or u/2
+        __m256i halfu = _mm256_cmpgt_epi64(hu, _mm256_set1_epi64x(0x6a09d));
+        k = _mm256_sub_epi64(k, halfu);
+        u = _mm256_castsi256_pd(_mm256_or_si256(_mm256_and_si256(ubits, _mm256_set1_epi64x(FP64_MANTISSA_MASK)),
+            _mm256_blendv_epi8(_mm256_set1_epi64x(0x3ff0000000000000ll), _mm256_set1_epi64x(0x3fe0000000000000ll), halfu)));
+        hu = _mm256_blendv_epi8(hu, _mm256_srli_epi64(_mm256_sub_epi64(_mm256_set1_epi64x(0x00100000), hu), 2), halfu);
+
+        // merge in the k = 0 case
+        __m256d f = _mm256_blendv_pd(_mm256_sub_pd(u, one), x, _mm256_castsi256_pd(kzero));
+        k = _mm256_andnot_si256(kzero, k);
+        hu = _mm256_blendv_epi8(hu, _mm256_set1_epi64x(1), kzero);
+        __m256d kd = cvtepi64_pd_small_x4(k);
+        __m256d kiszero = _mm256_castsi256_pd(_mm256_cmpeq_epi64(k, zeroi));
+        __m256d hfsq = _mm256_mul_pd(_mm256_mul_pd(_mm256_set1_pd(0.5), f), f);
+
+        // |f| < 2**-20 uses a shorter series
+        __m256d fzero = _mm256_cmp_pd(f, zero, _CMP_EQ_OQ);
+        __m256d Rs = _mm256_mul_pd(hfsq, _mm256_sub_pd(one, _mm256_mul_pd(_mm256_set1_pd(0.66666666666666666), f)));
+        __m256d smallterm = _mm256_blendv_pd(
+            _mm256_sub_pd(_mm256_mul_pd(kd, ln2_hi), _mm256_sub_pd(_mm256_sub_pd(Rs, _mm256_add_pd(_mm256_mul_pd(kd, ln2_lo), c)), f)),
+            _mm256_sub_pd(f, Rs), kiszero);
+        smallterm = _mm256_blendv_pd(smallterm, _mm256_add_pd(_mm256_mul_pd(kd, ln2_hi), _mm256_add_pd(c, _mm256_mul_pd(kd, ln2_lo))), fzero);
+
+        // main polynomial
+        __m256d s = _mm256_div_pd(f, _mm256_add_pd(_mm256_set1_pd(2.0), f));
+        __m256d z = _mm256_mul_pd(s, s);
+        __m256d R1 = _mm256_mul_pd(z, _mm256_set1_pd(s_log_lg[1].as_double()));
+        __m256d z2 = _mm256_mul_pd(z, z);
+        __m256d R2 = _mm256_add_pd(_mm256_set1_pd(s_log_lg[2].as_double()), _mm256_mul_pd(z, _mm256_set1_pd(s_log_lg[3].as_double())));
+        __m256d z4 = _mm256_mul_pd(z2, z2);
+        __m256d R3 = _mm256_add_pd(_mm256_set1_pd(s_log_lg[4].as_double()), _mm256_mul_pd(z, _mm256_set1_pd(s_log_lg[5].as_double())));
+        __m256d z6 = _mm256_mul_pd(z4, z2);
+        __m256d R4 = _mm256_add_pd(_mm256_set1_pd(s_log_lg[6].as_double()), _mm256_mul_pd(z, _mm256_set1_pd(s_log_lg[7].as_double())));
+        __m256d R = _mm256_add_pd(_mm256_add_pd(_mm256_add_pd(R1, _mm256_mul_pd(z2, R2)), _mm256_mul_pd(z4, R3)), _mm256_mul_pd(z6, R4));
+        __m256d sR = _mm256_mul_pd(s, _mm256_add_pd(hfsq, R));
+        __m256d term = _mm256_blendv_pd(
+            _mm256_sub_pd(_mm256_mul_pd(kd, ln2_hi), _mm256_sub_pd(_mm256_sub_pd(hfsq, _mm256_add_pd(sR, _mm256_add_pd(_mm256_mul_pd(kd, ln2_lo), c))), f)),
+            _mm256_sub_pd(f, _mm256_sub_pd(hfsq, sR)), kiszero);
+
+        // select the path for each lane and compute the result
+        __m256i hu0 = _mm256_cmpeq_epi64(hu, zeroi);
+        term = _mm256_blendv_pd(term, smallterm, _mm256_castsi256_pd(hu0));
+        term = _mm256_blendv_pd(term, tinyterm, _mm256_castsi256_pd(tiny));
+        __m256d result = fpext64x4_t::mul(fpext64x4_t(term), src2invln2).as_fp64();
+
+        // f == 0 with k == 0 returns +0 directly
+        __m256d exactzero = _mm256_and_pd(_mm256_andnot_pd(_mm256_castsi256_pd(tiny), _mm256_castsi256_pd(hu0)), _mm256_and_pd(fzero, kiszero));
+        result = _mm256_andnot_pd(exactzero, result);
+        _mm256_storeu_pd(reinterpret_cast<double *>(&dst[index]), result);
+
+        // everything but a zero src1 is inexact
+        __m256i exact = _mm256_cmpeq_epi64(abs1, zeroi);
+        flags = _mm256_or_si256(flags, _mm256_andnot_si256(_mm256_or_si256(special, exact), _mm256_set1_epi64x(X87SW_PRECISION_EX)));
+
+        return special;
+    }
+#endif
+};
+
+uint16_t fp64_t::x87_fyl2xp1_batch(fp64_t const *src1, fp64_t const *src2, fp64_t *dst, size_t count)
+{
+    return run_batch<fyl2xp1_batch_kernel>(count, src1, src2, dst);
+}
+
+
 
 //===========================================================================
 //
@@ -1241,8 +2073,8 @@ static uint32_t reduce_trig(fp64_t src, FpType &delta)
     // multiply by invpio4, which is a 1.127 value; final result is
     // 2.190; since invpio4 has a 0 exponent, we don't need to adjust
     // for that
-    static const uint64_t INV_PIO4_HI = 0xa2f9836e4e44152aull;
-    static const uint64_t INV_PIO4_LO = 0x00062bc40da28000ull;
+    static constexpr uint64_t INV_PIO4_HI = 0xa2f9836e4e44152aull;
+    static constexpr uint64_t INV_PIO4_LO = 0x00062bc40da28000ull;
     auto [divmid, divhi] = multiply_64x64(srcman, INV_PIO4_HI);
     auto [divlo, hitemp] = multiply_64x64(srcman, INV_PIO4_LO);
     divmid += hitemp;
@@ -1261,8 +2093,8 @@ static uint32_t reduce_trig(fp64_t src, FpType &delta)
     // now compute the result times pio4 to high precision; this multiplies
     // the 1.127 pio4 value by a scalar giving a 65.127 result with exponent -1,
     // or effectively a 64.128 value
-    static const uint64_t PIO4_HI = 0xc90fdaa22168c234ull;
-    static const uint64_t PIO4_LO = 0xc000000000000000ull;
+    static constexpr uint64_t PIO4_HI = 0xc90fdaa22168c234ull;
+    static constexpr uint64_t PIO4_LO = 0xc000000000000000ull;
     auto [mulmid, mulhi] = multiply_64x64(result, PIO4_HI);
     auto [mullo, hitemp2] = multiply_64x64(result, PIO4_LO);
     mulmid += hitemp2;
@@ -1322,12 +2154,12 @@ template<typename FpType>
 static uint32_t reduce_trig_alt(fp64_t src, FpType &delta)
 {
     using fpext_t = fpext96_t;
-    static const fpext_t pi     (0xc90fdaa22168c234ull, 0xc0000000,  1, 0);  // (3.141592653589e+00)
-    static const fpext_t pio2   (0xc90fdaa22168c234ull, 0xc0000000,  0, 0);  // (1.570796326794e+00)
-    static const fpext_t pio4   (0xc90fdaa22168c234ull, 0xc0000000, -1, 0);  // (7.853981633974e-01)
-    static const fpext_t pio4_hi(0xc90fdaa200000000ull, 0x00000000, -1, 0);  // (7.853981633671e-01)
-    static const fpext_t pio4_lo(0x85a308d300000000ull, 0x00000000, -35, 0); // (3.038550253152e-11)
-    static const fpext_t invpio4(0xa2f9836e4e44152aull, 0x00062bc4,  0, 0);  // (1.273239544735e+00)
+    static constexpr fpext_t pi     (0xc90fdaa22168c234ull, 0xc0000000,  1, 0);  // (3.141592653589e+00)
+    static constexpr fpext_t pio2   (0xc90fdaa22168c234ull, 0xc0000000,  0, 0);  // (1.570796326794e+00)
+    static constexpr fpext_t pio4   (0xc90fdaa22168c234ull, 0xc0000000, -1, 0);  // (7.853981633974e-01)
+    static constexpr fpext_t pio4_hi(0xc90fdaa200000000ull, 0x00000000, -1, 0);  // (7.853981633671e-01)
+    static constexpr fpext_t pio4_lo(0x85a308d300000000ull, 0x00000000, -35, 0); // (3.038550253152e-11)
+    static constexpr fpext_t invpio4(0xa2f9836e4e44152aull, 0x00062bc4,  0, 0);  // (1.273239544735e+00)
 
     // convert src to FpType in delta
     src = fp64_t::abs(src);
@@ -1359,6 +2191,99 @@ static uint32_t reduce_trig_alt(fp64_t src, FpType &delta)
     return uint32_t(j);
 }
 
+#if X87_SIMD_X64
+
+//
+// 4-lane version of reduce_trig for fpext106_t results, returned as separate
+// hi and lo vectors; src lanes must be normal with exponents < 63. Lanes
+// where the reduction cancels all the way into the low 64 bits are rare and
+// are flagged in special for the caller to handle with the scalar code
+//
+X87_TARGET_AVX2 static __m256i reduce_trig_x4(__m256i srcbits, __m256d &delta, __m256d &delta_lo, __m256i &special)
+{
+    __m256i const zero = _mm256_setzero_si256();
+    __m256i const one = _mm256_set1_epi64x(1);
+    __m256i const sixtyfour = _mm256_set1_epi64x(64);
+
+    // work on the absolute value; anything < pi/4 is returned as-is
+    __m256i absbits = _mm256_and_si256(srcbits, _mm256_set1_epi64x(FP64_ABS_MASK));
+    __m256i small = _mm256_castpd_si256(_mm256_cmp_pd(_mm256_castsi256_pd(absbits), _mm256_set1_pd(0.7853981633974483096), _CMP_LT_OQ));
+
+    // srcman is 1.63*2^srcexp
+    __m256i srcman = _mm256_or_si256(_mm256_slli_epi64(absbits, 63 - FP64_EXPONENT_SHIFT), _mm256_set1_epi64x(fpext52_t::EXPLICIT_ONE));
+    __m256i srcexp = _mm256_sub_epi64(_mm256_srli_epi64(absbits, FP64_EXPONENT_SHIFT), _mm256_set1_epi64x(FP64_EXPONENT_BIAS));
+
+    // multiply by invpio4, which is a 1.127 value
+    __m256i divmid, divhi, divlo, hitemp;
+    multiply_64x64_x4(srcman, _mm256_set1_epi64x(0xa2f9836e4e44152all), divmid, divhi);
+    multiply_64x64_x4(srcman, _mm256_set1_epi64x(0x00062bc40da28000ll), divlo, hitemp);
+    divmid = _mm256_add_epi64(divmid, hitemp);
+    divhi = _mm256_sub_epi64(divhi, cmplt_epu64_x4(divmid, hitemp));
+
+    // now find the floor, always returning an even value
+    __m256i result = _mm256_srlv_epi64(divhi, _mm256_sub_epi64(_mm256_set1_epi64x(62), srcexp));
+    __m256i evenodd = _mm256_and_si256(result, one);
+    result = _mm256_add_epi64(result, evenodd);
+
+    // compute the result times pio4 to high precision
+    __m256i mulmid, mulhi, mullo, hitemp2;
+    multiply_64x64_x4(result, _mm256_set1_epi64x(0xc90fdaa22168c234ll), mulmid, mulhi);
+    multiply_64x64_x4(result, _mm256_set1_epi64x(0xc000000000000000ll), mullo, hitemp2);
+    mulmid = _mm256_add_epi64(mulmid, hitemp2);
+    mulhi = _mm256_sub_epi64(mulhi, cmplt_epu64_x4(mulmid, hitemp2));
+
+    // align with src; a left shift by 64 yields 0, which covers the no-shift case
+    __m256i shift = _mm256_add_epi64(srcexp, one);
+    __m256i lshift = _mm256_sub_epi64(sixtyfour, shift);
+    mullo = _mm256_or_si256(_mm256_srlv_epi64(mullo, shift), _mm256_sllv_epi64(mulmid, lshift));
+    mulmid = _mm256_or_si256(_mm256_srlv_epi64(mulmid, shift), _mm256_sllv_epi64(mulhi, lshift));
+
+    // do the subtraction in whichever direction keeps the result positive
+    __m256i isodd = _mm256_cmpeq_epi64(evenodd, one);
+    __m256i evenman = _mm256_sub_epi64(_mm256_sub_epi64(srcman, mulmid), one);
+    __m256i oddman = _mm256_sub_epi64(mulmid, srcman);
+    srcman = _mm256_blendv_epi8(evenman, oddman, isodd);
+    mullo = _mm256_blendv_epi8(_mm256_sub_epi64(zero, mullo), mullo, isodd);
+
+    // flag total cancellation; otherwise normalize
+    special = _mm256_andnot_si256(small, _mm256_cmpeq_epi64(srcman, zero));
+    __m256i lz = clz_x4_avx2<uint64_t>(srcman);
+    srcman = _mm256_or_si256(_mm256_sllv_epi64(srcman, lz), _mm256_srlv_epi64(mullo, _mm256_sub_epi64(sixtyfour, lz)));
+    mullo = _mm256_sllv_epi64(mullo, lz);
+    srcexp = _mm256_sub_epi64(srcexp, lz);
+
+    // assemble the high part with the same rounding as the fpext52_t constructor;
+    // the exponent is always in the normal range here
+    __m256i sign = _mm256_slli_epi64(isodd, FP64_SIGN_SHIFT);
+    __m256i bits = _mm256_or_si256(sign, _mm256_slli_epi64(_mm256_add_epi64(srcexp, _mm256_set1_epi64x(FP64_EXPONENT_BIAS)), FP64_EXPONENT_SHIFT));
+    bits = _mm256_or_si256(bits, _mm256_and_si256(_mm256_srli_epi64(srcman, 63 - FP64_EXPONENT_SHIFT), _mm256_set1_epi64x(FP64_MANTISSA_MASK)));
+    bits = _mm256_add_epi64(bits, _mm256_and_si256(_mm256_srli_epi64(srcman, 62 - FP64_EXPONENT_SHIFT), one));
+
+    // the low part is the signed remainder of the top 96 bits after rounding,
+    // scaled by 2^(srcexp-116), matching the fpext106_t constructor
+    __m256i rest = _mm256_or_si256(_mm256_slli_epi64(srcman, 53), _mm256_srli_epi64(_mm256_and_si256(mullo, _mm256_set1_epi64x(0xffffffff00000000ll)), 11));
+    __m256i restsign = _mm256_cmpgt_epi64(zero, rest);
+    __m256d lo = cvtepu64_pd_x4(_mm256_sub_epi64(_mm256_xor_si256(rest, restsign), restsign));
+    __m256i scale = _mm256_slli_epi64(_mm256_add_epi64(srcexp, _mm256_set1_epi64x(FP64_EXPONENT_BIAS - 116)), FP64_EXPONENT_SHIFT);
+    lo = _mm256_mul_pd(lo, _mm256_castsi256_pd(scale));
+    lo = _mm256_xor_pd(lo, _mm256_castsi256_pd(_mm256_xor_si256(sign, _mm256_slli_epi64(restsign, FP64_SIGN_SHIFT))));
+
+    delta = _mm256_castsi256_pd(_mm256_blendv_epi8(bits, absbits, small));
+    delta_lo = _mm256_andnot_pd(_mm256_castsi256_pd(small), lo);
+    return _mm256_andnot_si256(small, result);
+}
+
+//
+// variant of the above for fpext52_t results
+//
+X87_TARGET_AVX2 static __m256i reduce_trig_x4(__m256i srcbits, __m256d &delta, __m256i &special)
+{
+    __m256d delta_lo;
+    return reduce_trig_x4(srcbits, delta, delta_lo, special);
+}
+
+#endif
+
 
 
 //===========================================================================
@@ -1370,34 +2295,35 @@ static uint32_t reduce_trig_alt(fp64_t src, FpType &delta)
 //
 //===========================================================================
 
+// accuracy/speed results:
+//   fpext52_t: 107536(0) / 20706(1) /  442(2), 0.11 ticks
+//   fpext64_t: 107020(0) / 19776(1) / 1888(2), 0.59 ticks
+//   fpext96_t: 107020(0) / 19776(1) / 1888(2), 1.11 ticks
+using fpexttan_t = fpext52_t;
+
+static constexpr std::array<fpexttan_t, 3> s_tancoeffs_p =
+{
+    fpexttan_t(0xcc96c69279f9bc1cull, 0x3df84886, 13, 1),  // (-1.309369391814e+04)
+    fpexttan_t(0x8ccf652fe4eee5b1ull, 0x4f58e5c3, 20, 0),  // (1.153516648386e+06)
+    fpexttan_t(0x88ff56994c8baf99ull, 0x8b70bfaf, 24, 1),  // (-1.795652519765e+07)
+};
+static constexpr std::array<fpexttan_t, 4> s_tancoeffs_q =
+{
+    fpexttan_t(0xd5c52f759b2b8ed3ull, 0xe2c5b9a6, 13, 0),  // (1.368129634707e+04)
+    fpexttan_t(0xa13de2c155e4adcdull, 0x58dfd25f, 20, 1),  // (-1.320892344402e+06)
+    fpexttan_t(0xbecc7e1756c77adfull, 0x21bc5195, 24, 0),  // (2.500838018234e+07)
+    fpexttan_t(0xcd7f01e5f2d186f6ull, 0x1dc3e1c7, 25, 1),  // (-5.386957559295e+07)
+};
+
 uint16_t fp64_t::x87_fptan(fp64_t const &src, fp64_t &dst1, fp64_t &dst2)
 {
     // only works for exponents < 63
     if (src.exponent() >= 63)
         goto oob;
 
-    // accuracy/speed results:
-    //   fpext52_t: 107536(0) / 20706(1) /  442(2), 0.11 ticks
-    //   fpext64_t: 107020(0) / 19776(1) / 1888(2), 0.59 ticks
-    //   fpext96_t: 107020(0) / 19776(1) / 1888(2), 1.11 ticks
-    using fpext_t = fpext52_t;
-
-    // constants
-    static std::array<fpext_t, 3> const P =
-    {
-        fpext_t(0xcc96c69279f9bc1cull, 0x3df84886, 13, 1),  // (-1.309369391814e+04)
-        fpext_t(0x8ccf652fe4eee5b1ull, 0x4f58e5c3, 20, 0),  // (1.153516648386e+06)
-        fpext_t(0x88ff56994c8baf99ull, 0x8b70bfaf, 24, 1),  // (-1.795652519765e+07)
-    };
-    static std::array<fpext_t, 4> const Q =
     {
-        fpext_t(0xd5c52f759b2b8ed3ull, 0xe2c5b9a6, 13, 0),  // (1.368129634707e+04)
-        fpext_t(0xa13de2c155e4adcdull, 0x58dfd25f, 20, 1),  // (-1.320892344402e+06)
-        fpext_t(0xbecc7e1756c77adfull, 0x21bc5195, 24, 0),  // (2.500838018234e+07)
-        fpext_t(0xcd7f01e5f2d186f6ull, 0x1dc3e1c7, 25, 1),  // (-5.386957559295e+07)
-    };
+        using fpext_t = fpexttan_t;
 
-    {
         fpext_t z;
         uint32_t j = reduce_trig(src, z);
 
@@ -1406,7 +2332,7 @@ uint16_t fp64_t::x87_fptan(fp64_t const &src, fp64_t &dst1, fp64_t &dst2)
 
         fpext_t zz = z * z;
         if (zz.exponent() > -67)
-            dst2 = z.as_fp64() + (z * zz * poly_eval(zz, P)).as_fp64() / poly1_eval(zz, Q).as_fp64();
+            dst2 = z.as_fp64() + (z * zz * poly_eval(zz, s_tancoeffs_p)).as_fp64() / poly1_eval(zz, s_tancoeffs_q).as_fp64();
         else
             dst2 = z.as_fp64();
 
@@ -1435,6 +2361,72 @@ oob:
 }
 
 
+//
+// batch kernel
+//
+struct fptan_batch_kernel
+{
+    //
+    // scalar version
+    //
+    static uint16_t scalar(size_t index, fp64_t const *src, fp64_t *dst1, fp64_t *dst2)
+    {
+        return fp64_t::x87_fptan(src[index], dst1[index], dst2[index]);
+    }
+
+#if X87_SIMD_X64
+    //
+    // AVX2 version: the reduction and the P/Q rational run across 4 lanes, with
+    // the small zz shortcut and the cotangent step selected per lane. Zeros,
+    // denormals, out-of-range values, and the rare lanes that reduce_trig_x4
+    // can't handle are redone by the scalar code. Only AVX2 is used because
+    // allowing AVX-512 would also allow FMA contraction, which would change the
+    // results
+    //
+    X87_TARGET_AVX2 static __m256i avx2(size_t index, __m256i &flags, fp64_t const *src, fp64_t *dst1, fp64_t *dst2)
+    {
+        __m256i const expmask = _mm256_set1_epi64x(FP64_EXPONENT_MASK);
+        __m256i const signmask = _mm256_set1_epi64x(FP64_SIGN_MASK);
+        __m256i const two = _mm256_set1_epi64x(2);
+        __m256d const one = _mm256_set1_pd(1.0);
+
+        __m256i srcbits = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(&src[index]));
+
+        // zeros/denormals and exponents >= 63 (including infinities/NaNs) are special
+        __m256i exponent = _mm256_and_si256(srcbits, expmask);
+        __m256i special = _mm256_or_si256(_mm256_cmpeq_epi64(exponent, _mm256_setzero_si256()),
+            _mm256_cmpgt_epi64(exponent, _mm256_set1_epi64x(int64_t(FP64_EXPONENT_BIAS + 62) << FP64_EXPONENT_SHIFT)));
+
+        // reduce and evaluate the rational; tiny zz values just use z
+        __m256d z;
+        __m256i reduce_special;
+        __m256i j = reduce_trig_x4(srcbits, z, reduce_special);
+        special = _mm256_or_si256(special, reduce_special);
+        __m256d zz = _mm256_mul_pd(z, z);
+        __m256d result = _mm256_add_pd(z, _mm256_div_pd(_mm256_mul_pd(_mm256_mul_pd(z, zz), poly_eval_x4(zz, s_tancoeffs_p)), poly1_eval_x4(zz, s_tancoeffs_q)));
+        __m256i bigzz = _mm256_cmpgt_epi64(_mm256_castpd_si256(zz), _mm256_set1_epi64x((int64_t(FP64_EXPONENT_BIAS - 66) << FP64_EXPONENT_SHIFT) - 1));
+        result = _mm256_blendv_pd(z, result, _mm256_castsi256_pd(bigzz));
+
+        // odd quadrants produce the cotangent; then apply the sign
+        result = _mm256_blendv_pd(result, _mm256_div_pd(_mm256_set1_pd(-1.0), result), _mm256_castsi256_pd(_mm256_cmpeq_epi64(_mm256_and_si256(j, two), two)));
+        result = _mm256_xor_pd(result, _mm256_castsi256_pd(_mm256_and_si256(srcbits, signmask)));
+        _mm256_storeu_pd(reinterpret_cast<double *>(&dst2[index]), result);
+        _mm256_storeu_pd(reinterpret_cast<double *>(&dst1[index]), one);
+
+        // every non-special lane is inexact
+        flags = _mm256_or_si256(flags, _mm256_andnot_si256(special, _mm256_set1_epi64x(X87SW_PRECISION_EX)));
+
+        return special;
+    }
+#endif
+};
+
+uint16_t fp64_t::x87_fptan_batch(fp64_t const *src, fp64_t *dst1, fp64_t *dst2, size_t count)
+{
+    return run_batch<fptan_batch_kernel>(count, src, dst1, dst2);
+}
+
+
 
 //===========================================================================
 //
@@ -1452,9 +2444,15 @@ oob:
 //   fpext52_t:  76302(0) / 52242(1) / 140(2), 0.34 ticks
 //   fpext64_t: 110016(0) / 18668(1) /   0(2), 1.36 ticks
 //   fpext96_t: 124936(0) /  3748(1) /   0(2), 2.93 ticks
+// the coefficients are stored as fpext52_t but evaluated with compensated
+// Horner over an fpext106_t reduction; against hardware in 53-bit chop mode,
+// 2M random inputs in [-100, 100]:
+//   fpext52_t:   fsin 982372(0) / 1010535(1) / 7093(2), fcos 981578(0) / 1011398(1) / 7024(2)
+//   compensated: fsin 1986552(0) / 13448(1) / 0(2), fcos 1986368(0) / 13632(1) / 0(2)
+//   Estrin head: fsin 1986556(0) / 13444(1) / 0(2), fcos 1986382(0) / 13618(1) / 0(2)
 using fpextsincos_t = fpext52_t;
 
-static std::array<fpextsincos_t, 7> const s_sincoeffs =
+static constexpr std::array<fpextsincos_t, 7> s_sincoeffs =
 {
     fpextsincos_t(0xd5512389e1d64e26ull, 0x9f89cf50, -41, 1),  // (-7.578540409484e-13)
     fpextsincos_t(0xb0904623e70664d7ull, 0x67a8f274, -33, 0),  // (1.605836316732e-10)
@@ -1464,7 +2462,7 @@ static std::array<fpextsincos_t, 7> const s_sincoeffs =
     fpextsincos_t(0x8888888888885699ull, 0xb8fd9374,  -7, 0),  // (8.333333333333e-03)
     fpextsincos_t(0xaaaaaaaaaaaaaa97ull, 0x2da4d5f5,  -3, 1),  // (-1.666666666667e-01)
 };
-static std::array<fpextsincos_t, 7> const s_coscoeffs =
+static constexpr std::array<fpextsincos_t, 7> s_coscoeffs =
 {
     fpextsincos_t(0xd55e8c3a6f997436ull, 0x5436d2ee, -45, 0),  // (4.737750796425e-14)
     fpextsincos_t(0xc9c9920f58f42f36ull, 0xfafa14fe, -37, 1),  // (-1.147028484343e-11)
@@ -1475,6 +2473,18 @@ static std::array<fpextsincos_t, 7> const s_coscoeffs =
     fpextsincos_t(0xaaaaaaaaaaaaaa99ull, 0xa9939f52,  -5, 0),  // (4.166666666667e-02)
 };
 
+// the same series as plain doubles for compensated evaluation, with the
+// leading terms folded in: sin(z) = z * S(z*z), cos(z) = C(z*z)
+static constexpr auto s_sinterms = compensated_terms(s_sincoeffs, 1.0);
+static constexpr auto s_costerms = compensated_terms(s_coscoeffs, -0.5, 1.0);
+
+// number of leading terms of either series evaluated with plain Estrin;
+// |z*z| <= (pi/4)^2, so their rounding error, scaled by the remaining
+// powers of z*z, stays below 2^-60 of the result, and the compensated steps
+// only run for the last 2 (sin) or 3 (cos) terms; this cuts scalar fsin and
+// fcos by 10-25% and the batch versions by about 30%
+static constexpr size_t s_sincos_head = 6;
+
 uint16_t fp64_t::x87_fsin(fp64_t const &src, fp64_t &dst)
 {
     // only works for exponents < 63
@@ -1482,19 +2492,17 @@ uint16_t fp64_t::x87_fsin(fp64_t const &src, fp64_t &dst)
         goto oob;
 
     {
-        using fpext_t = fpextsincos_t;
-
         auto sign = src.sign();
         uint16_t flags = src.iszero() ? 0 : src.isdenorm() ? (X87SW_PRECISION_EX | X87SW_DENORM_EX) : X87SW_PRECISION_EX;
 
-        fpext_t z;
+        fpext106_t z;
         uint32_t j = reduce_trig(src, z);
 
-        fpext_t zz = z * z;
+        fpext106_t zz = z * z;
         if (((j + 1) & 2) != 0)
-            dst = (fpext_t::one - fpext_t::ldexp(zz, -1) + zz * zz * poly_eval(zz, s_coscoeffs)).as_fp64();
+            dst = poly_eval_compensated<s_sincos_head>(zz, s_costerms).as_fp64();
         else
-            dst = (z + z * zz * poly_eval(zz, s_sincoeffs)).as_fp64();
+            dst = (z * poly_eval_compensated<s_sincos_head>(zz, s_sinterms)).as_fp64();
 
         if (((sign ^ (j >> 2)) & 1) != 0)
             dst = fp64_t::chs(dst);
@@ -1521,19 +2529,17 @@ uint16_t fp64_t::x87_fcos(fp64_t const &src, fp64_t &dst)
         goto oob;
 
     {
-        using fpext_t = fpextsincos_t;
-
-        fpext_t z;
+        fpext106_t z;
         uint32_t j = reduce_trig(src, z);
 
         auto sign = src.sign();
         uint16_t flags = src.iszero() ? 0 : src.isdenorm() ? (X87SW_PRECISION_EX | X87SW_DENORM_EX) : X87SW_PRECISION_EX;
 
-        fpext_t zz = z * z;
+        fpext106_t zz = z * z;
         if (((j + 1) & 2) != 0)
-            dst = (z + z * zz * poly_eval(zz, s_sincoeffs)).as_fp64();
+            dst = (z * poly_eval_compensated<s_sincos_head>(zz, s_sinterms)).as_fp64();
         else
-            dst = (fpext_t::one - fpext_t::ldexp(zz, -1) + zz * zz * poly_eval(zz, s_coscoeffs)).as_fp64();
+            dst = poly_eval_compensated<s_sincos_head>(zz, s_costerms).as_fp64();
 
         if ((((j >> 1) ^ j) & 2) != 0)
             dst = fp64_t::chs(dst);
@@ -1560,17 +2566,15 @@ uint16_t fp64_t::x87_fsincos(fp64_t const &src, fp64_t &dst1, fp64_t &dst2)
         goto oob;
 
     {
-        using fpext_t = fpextsincos_t;
-
-        fpext_t z;
+        fpext106_t z;
         uint32_t j = reduce_trig(src, z);
 
         auto sign = src.sign();
         uint16_t flags = src.iszero() ? 0 : src.isdenorm() ? (X87SW_PRECISION_EX | X87SW_DENORM_EX) : X87SW_PRECISION_EX;
 
-        fpext_t zz = z * z;
-        fp64_t res1 = (z + z * zz * poly_eval(zz, s_sincoeffs)).as_fp64();
-        fp64_t res2 = (fpext_t::one - fpext_t::ldexp(zz, -1) + zz * zz * poly_eval(zz, s_coscoeffs)).as_fp64();
+        fpext106_t zz = z * z;
+        fp64_t res1 = (z * poly_eval_compensated<s_sincos_head>(zz, s_sinterms)).as_fp64();
+        fp64_t res2 = poly_eval_compensated<s_sincos_head>(zz, s_costerms).as_fp64();
         if (((j + 1) & 2) != 0)
         {
             dst1 = res1;
@@ -1607,6 +2611,104 @@ oob:
 
 
 
+//
+// batch kernel
+//
+template<bool WantSin, bool WantCos>
+struct sincos_batch_kernel
+{
+    //
+    // scalar version
+    //
+    static uint16_t scalar(size_t index, fp64_t const *src, fp64_t *sindst, fp64_t *cosdst)
+    {
+        if constexpr (WantSin && WantCos)
+            return fp64_t::x87_fsincos(src[index], cosdst[index], sindst[index]);
+        else if constexpr (WantSin)
+            return fp64_t::x87_fsin(src[index], sindst[index]);
+        else
+            return fp64_t::x87_fcos(src[index], cosdst[index]);
+    }
+
+#if X87_SIMD_X64
+    //
+    // AVX2 version: the reduction and both polynomials run across 4 lanes as
+    // double-doubles. Zeros, denormals, out-of-range values, and the rare lanes
+    // that reduce_trig_x4 can't handle are redone by the scalar code. Only AVX2
+    // is used because allowing AVX-512 would also allow FMA contraction, which
+    // would break the error-free transformations
+    //
+    X87_TARGET_AVX2 static __m256i avx2(size_t index, __m256i &flags, fp64_t const *src, fp64_t *sindst, fp64_t *cosdst)
+    {
+        __m256i const expmask = _mm256_set1_epi64x(FP64_EXPONENT_MASK);
+        __m256i const signmask = _mm256_set1_epi64x(FP64_SIGN_MASK);
+        __m256i const one = _mm256_set1_epi64x(1);
+        __m256i const two = _mm256_set1_epi64x(2);
+
+        __m256i srcbits = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(&src[index]));
+
+        // zeros/denormals and exponents >= 63 (including infinities/NaNs) are special
+        __m256i exponent = _mm256_and_si256(srcbits, expmask);
+        __m256i special = _mm256_or_si256(_mm256_cmpeq_epi64(exponent, _mm256_setzero_si256()),
+            _mm256_cmpgt_epi64(exponent, _mm256_set1_epi64x(int64_t(FP64_EXPONENT_BIAS + 62) << FP64_EXPONENT_SHIFT)));
+
+        // reduce and evaluate both polynomials
+        __m256d zhi, zlo, zzhi, zzlo, hi, lo;
+        __m256i reduce_special;
+        __m256i j = reduce_trig_x4(srcbits, zhi, zlo, reduce_special);
+        special = _mm256_or_si256(special, reduce_special);
+        mul_dd_x4(zhi, zlo, zhi, zlo, zzhi, zzlo);
+        poly_eval_compensated_x4<s_sincos_head>(zzhi, zzlo, s_sinterms, hi, lo);
+        mul_dd_x4(zhi, zlo, hi, lo, hi, lo);
+        __m256d sinres = truncate_dd_x4(hi, lo);
+        poly_eval_compensated_x4<s_sincos_head>(zzhi, zzlo, s_costerms, hi, lo);
+        __m256d cosres = truncate_dd_x4(hi, lo);
+
+        // pick the series for each lane based on the quadrant and apply signs
+        __m256d swap = _mm256_castsi256_pd(_mm256_cmpeq_epi64(_mm256_and_si256(_mm256_add_epi64(j, one), two), two));
+        if constexpr (WantSin)
+        {
+            __m256i flip = _mm256_slli_epi64(_mm256_xor_si256(_mm256_srli_epi64(srcbits, FP64_SIGN_SHIFT), _mm256_srli_epi64(j, 2)), FP64_SIGN_SHIFT);
+            __m256d result = _mm256_blendv_pd(sinres, cosres, swap);
+            result = _mm256_xor_pd(result, _mm256_castsi256_pd(_mm256_and_si256(flip, signmask)));
+            _mm256_storeu_pd(reinterpret_cast<double *>(&sindst[index]), result);
+        }
+        if constexpr (WantCos)
+        {
+            __m256i flip = _mm256_slli_epi64(_mm256_xor_si256(_mm256_srli_epi64(j, 1), j), FP64_SIGN_SHIFT - 1);
+            __m256d result = _mm256_blendv_pd(cosres, sinres, swap);
+            result = _mm256_xor_pd(result, _mm256_castsi256_pd(_mm256_and_si256(flip, signmask)));
+            _mm256_storeu_pd(reinterpret_cast<double *>(&cosdst[index]), result);
+        }
+
+        // every non-special lane is inexact
+        flags = _mm256_or_si256(flags, _mm256_andnot_si256(special, _mm256_set1_epi64x(X87SW_PRECISION_EX)));
+
+        return special;
+    }
+#endif
+};
+
+//
+// entry points
+//
+uint16_t fp64_t::x87_fsin_batch(fp64_t const *src, fp64_t *dst, size_t count)
+{
+    return run_batch<sincos_batch_kernel<true, false>>(count, src, dst, nullptr);
+}
+
+uint16_t fp64_t::x87_fcos_batch(fp64_t const *src, fp64_t *dst, size_t count)
+{
+    return run_batch<sincos_batch_kernel<false, true>>(count, src, nullptr, dst);
+}
+
+uint16_t fp64_t::x87_fsincos_batch(fp64_t const *src, fp64_t *dst1, fp64_t *dst2, size_t count)
+{
+    return run_batch<sincos_batch_kernel<true, true>>(count, src, dst2, dst1);
+}
+
+
+
 //===========================================================================
 //
 // x87_fpatan
@@ -1617,6 +2719,44 @@ oob:
 //
 //===========================================================================
 
+// accuracy/speed results:
+//   fpext52_t: fails all over the place
+//   fpext64_t: 140342188(0) / 25263290(1) / 5683(2), 1.26 ticks
+//   fpext80_t: same results as fpext96_t, 2.60 ticks
+//   fpext96_t: 141032668(0) / 24572779(1) / 5714(2), 2.60 ticks
+using fpextatan_t = fpext64_t;
+
+static constexpr fpext_table_t s_atancoeffs_p = std::array<fpextatan_t, 5>
+{
+    fpextatan_t(0xde5f1266ce538eceull, 0x45933bae, -1, 1),  // (-8.686381817809e-01)
+    fpextatan_t(0xeaefa6bfa06107e6ull, 0x6f351563,  3, 1),  // (-1.468350863318e+01)
+    fpextatan_t(0xffe8557ff29153eeull, 0x47487583,  5, 1),  // (-6.397688865583e+01)
+    fpextatan_t(0xc7fa3f3eeda6f9d5ull, 0xa7a03a0c,  6, 1),  // (-9.998876377727e+01)
+    fpextatan_t(0xcb9393616abcb6c3ull, 0x53e3ffa9,  5, 1),  // (-5.089411689962e+01)
+};
+static constexpr fpext_table_t s_atancoeffs_q = std::array<fpextatan_t, 5>
+{
+    fpextatan_t(0xb7dae76e894e54d3ull, 0xee74072e,  4, 0),  // (2.298188673359e+01)
+    fpextatan_t(0x8ffdafa27a4676b8ull, 0xd644a00e,  7, 0),  // (1.439909612225e+02)
+    fpextatan_t(0xb4b86beee9c0e3a9ull, 0x5df2ff95,  8, 0),  // (3.614407938615e+02)
+    fpextatan_t(0xc3c9b09850a7abc0ull, 0xb934a367,  8, 0),  // (3.915757017511e+02)
+    fpextatan_t(0x98aeae89100d891bull, 0xd3dd1204,  7, 0),  // (1.526823506989e+02)
+};
+static constexpr double T3P8 = 2.41421356237309504880169;
+static constexpr double TP8 = 4.1421356237309504880169e-1;
+
+static constexpr double pi64 = 3.1415926535897932384626433832795;
+static constexpr double npi64 = -3.1415926535897932384626433832795;
+static constexpr double pio264 = 1.5707963267948966192313216916398;
+static constexpr double npio264 = -1.5707963267948966192313216916398;
+static constexpr double pio464 = 0.78539816339744830961566084581988;
+static constexpr double npio464 = -0.78539816339744830961566084581988;
+static constexpr double pi3o464 = 2.3561944901923449288469825374596;
+static constexpr double npi3o464 = -2.3561944901923449288469825374596;
+
+static constexpr fpextatan_t pio2(0xc90fdaa22168c234ull, 0xc0000000,  0, 0);  // (1.570796326794e+00)
+static constexpr fpextatan_t pio4(0xc90fdaa22168c234ull, 0xc0000000, -1, 0);  // (7.853981633974e-01)
+
 uint16_t fp64_t::x87_fpatan(fp64_t const &src1, fp64_t const &src2, fp64_t &dst)
 {
     // denorm flag is set regardless
@@ -1634,44 +2774,9 @@ uint16_t fp64_t::x87_fpatan(fp64_t const &src1, fp64_t const &src2, fp64_t &dst)
     if (src2.iszero())
         goto zeroy;
 
-    // accuracy/speed results:
-    //   fpext52_t: fails all over the place
-    //   fpext64_t: 140342188(0) / 25263290(1) / 5683(2), 1.26 ticks
-    //   fpext96_t: 141032668(0) / 24572779(1) / 5714(2), 2.60 ticks
-    using fpext_t = fpext64_t;
-
-    static std::array<fpext_t, 5> const P =
     {
-        fpext_t(0xde5f1266ce538eceull, 0x45933bae, -1, 1),  // (-8.686381817809e-01)
-        fpext_t(0xeaefa6bfa06107e6ull, 0x6f351563,  3, 1),  // (-1.468350863318e+01)
-        fpext_t(0xffe8557ff29153eeull, 0x47487583,  5, 1),  // (-6.397688865583e+01)
-        fpext_t(0xc7fa3f3eeda6f9d5ull, 0xa7a03a0c,  6, 1),  // (-9.998876377727e+01)
-        fpext_t(0xcb9393616abcb6c3ull, 0x53e3ffa9,  5, 1),  // (-5.089411689962e+01)
-    };
-    static std::array<fpext_t, 5> const Q =
-    {
-        fpext_t(0xb7dae76e894e54d3ull, 0xee74072e,  4, 0),  // (2.298188673359e+01)
-        fpext_t(0x8ffdafa27a4676b8ull, 0xd644a00e,  7, 0),  // (1.439909612225e+02)
-        fpext_t(0xb4b86beee9c0e3a9ull, 0x5df2ff95,  8, 0),  // (3.614407938615e+02)
-        fpext_t(0xc3c9b09850a7abc0ull, 0xb934a367,  8, 0),  // (3.915757017511e+02)
-        fpext_t(0x98aeae89100d891bull, 0xd3dd1204,  7, 0),  // (1.526823506989e+02)
-    };
-    static double const T3P8 = 2.41421356237309504880169;
-    static double const TP8 = 4.1421356237309504880169e-1;
-
-    static double const pi64 = 3.1415926535897932384626433832795;
-    static double const npi64 = -3.1415926535897932384626433832795;
-    static double const pio264 = 1.5707963267948966192313216916398;
-    static double const npio264 = -1.5707963267948966192313216916398;
-    static double const pio464 = 0.78539816339744830961566084581988;
-    static double const npio464 = -0.78539816339744830961566084581988;
-    static double const pi3o464 = 2.3561944901923449288469825374596;
-    static double const npi3o464 = -2.3561944901923449288469825374596;
-
-    static const fpext_t pio2(0xc90fdaa22168c234ull, 0xc0000000,  0, 0);  // (1.570796326794e+00)
-    static const fpext_t pio4(0xc90fdaa22168c234ull, 0xc0000000, -1, 0);  // (7.853981633974e-01)
+        using fpext_t = fpextatan_t;
 
-    {
         fp64_t x = src2 / src1;
 
         // make argument positive and save the sign
@@ -1702,7 +2807,7 @@ uint16_t fp64_t::x87_fpatan(fp64_t const &src1, fp64_t const &src2, fp64_t &dst)
         }
 
         fpext_t z = xext * xext;
-        yext = yext + poly_eval(z, P).div64(poly1_eval(z, Q)) * z * xext + xext;
+        yext = yext + poly_eval(z, s_atancoeffs_p).div64(poly1_eval(z, s_atancoeffs_q)) * z * xext + xext;
 
         if (sign)
             yext.chs();
@@ -1710,7 +2815,7 @@ uint16_t fp64_t::x87_fpatan(fp64_t const &src1, fp64_t const &src2, fp64_t &dst)
         int code = (src1.sign() << 1) | src2.sign();
         dst = yext.as_fp64();
 
-        static fp64_t const s_offsets[4] = { 0.0, 0.0, pi64, npi64 };
+        static constexpr fp64_t s_offsets[4] = { 0.0, 0.0, pi64, npi64 };
         dst += s_offsets[code];
 
         if (dst == 0 && src2.sign())
@@ -1777,4 +2882,81 @@ zeroy:
     return flags;
 }
 
+
+//
+// batch kernel
+//
+struct fpatan_batch_kernel
+{
+    //
+    // scalar version
+    //
+    static uint16_t scalar(size_t index, fp64_t const *src1, fp64_t const *src2, fp64_t *dst)
+    {
+        return fp64_t::x87_fpatan(src1[index], src2[index], dst[index]);
+    }
+
+#if X87_SIMD_X64
+    //
+    // AVX2 version: the range reduction is done with blends, and the P/Q
+    // rational runs across 4 lanes in fpext64x4_t. Zeros, denormals, infinities,
+    // and NaNs are redone by the scalar code. Only AVX2 is used because allowing
+    // AVX-512 would also allow FMA contraction, which would change the results
+    //
+    X87_TARGET_AVX2 static __m256i avx2(size_t index, __m256i &flags, fp64_t const *src1, fp64_t const *src2, fp64_t *dst)
+    {
+        __m256i const signmask = _mm256_set1_epi64x(FP64_SIGN_MASK);
+        __m256i const zeroi = _mm256_setzero_si256();
+        __m256d const zero = _mm256_setzero_pd();
+        __m256d const one = _mm256_set1_pd(1.0);
+
+        __m256i src1bits = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(&src1[index]));
+        __m256i src2bits = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(&src2[index]));
+
+        // both sources must be normal
+        __m256i special = _mm256_or_si256(slowpath_fp64_x4(src1bits), slowpath_fp64_x4(src2bits));
+
+        // make the argument positive and save the sign
+        __m256d x = _mm256_div_pd(_mm256_castsi256_pd(src2bits), _mm256_castsi256_pd(src1bits));
+        __m256d negative = _mm256_cmp_pd(x, zero, _CMP_LT_OQ);
+        x = _mm256_xor_pd(x, _mm256_and_pd(negative, _mm256_castsi256_pd(signmask)));
+
+        // range reduction
+        __m256d above3p8 = _mm256_cmp_pd(x, _mm256_set1_pd(T3P8), _CMP_GT_OQ);
+        __m256d abovep8 = _mm256_cmp_pd(x, _mm256_set1_pd(TP8), _CMP_GT_OQ);
+        __m256d xr = _mm256_blendv_pd(x, _mm256_div_pd(_mm256_sub_pd(x, one), _mm256_add_pd(x, one)), abovep8);
+        xr = _mm256_blendv_pd(xr, _mm256_div_pd(_mm256_set1_pd(-1.0), x), above3p8);
+        fpext64x4_t xext(xr);
+        fpext64x4_t yext(
+            _mm256_blendv_epi8(_mm256_blendv_epi8(zeroi, _mm256_set1_epi64x(int64_t(pio4.mantissa())), _mm256_castpd_si256(abovep8)), _mm256_set1_epi64x(int64_t(pio2.mantissa())), _mm256_castpd_si256(above3p8)),
+            _mm256_blendv_epi8(_mm256_blendv_epi8(_mm256_set1_epi64x(fpextatan_t::EXPONENT_MIN), _mm256_set1_epi64x(pio4.exponent()), _mm256_castpd_si256(abovep8)), _mm256_set1_epi64x(pio2.exponent()), _mm256_castpd_si256(above3p8)),
+            zeroi);
+
+        // evaluate the rational
+        fpext64x4_t z = fpext64x4_t::mul(xext, xext);
+        fpext64x4_t ratio(_mm256_div_pd(poly_eval_x4(z, s_atancoeffs_p).as_fp64(), poly1_eval_x4(z, s_atancoeffs_q).as_fp64()));
+        yext = fpext64x4_t::add(fpext64x4_t::add(yext, fpext64x4_t::mul(fpext64x4_t::mul(ratio, z), xext)), xext);
+        yext.m_sign = _mm256_xor_si256(yext.m_sign, _mm256_srli_epi64(_mm256_castpd_si256(negative), 63));
+
+        // add the quadrant offset; zero results take the sign of src2
+        __m256d offset = _mm256_and_pd(_mm256_castsi256_pd(_mm256_cmpgt_epi64(zeroi, src1bits)),
+            _mm256_or_pd(_mm256_set1_pd(pi64), _mm256_castsi256_pd(_mm256_and_si256(src2bits, signmask))));
+        __m256d result = _mm256_add_pd(yext.as_fp64(), offset);
+        __m256d iszero = _mm256_cmp_pd(result, zero, _CMP_EQ_OQ);
+        result = _mm256_xor_pd(result, _mm256_and_pd(iszero, _mm256_castsi256_pd(_mm256_and_si256(src2bits, signmask))));
+        _mm256_storeu_pd(reinterpret_cast<double *>(&dst[index]), result);
+
+        // every non-special lane is inexact
+        flags = _mm256_or_si256(flags, _mm256_andnot_si256(special, _mm256_set1_epi64x(X87SW_PRECISION_EX)));
+
+        return special;
+    }
+#endif
+};
+
+uint16_t fp64_t::x87_fpatan_batch(fp64_t const *src1, fp64_t const *src2, fp64_t *dst, size_t count)
+{
+    return run_batch<fpatan_batch_kernel>(count, src1, src2, dst);
+}
+
 }
@@ -89,6 +89,29 @@ inline rounding_applied_t round_in_place(uint64_t &mantissa, int &exponent, uint
 }
 
 
+//
+// x87 FXAM; returns the C3/C2/C0 class code with C1 set to the sign
+// Exceptions: none
+//
+uint16_t fp80_t::x87_fxam(fp80_t const &src)
+{
+    uint16_t result = src.sign() ? X87SW_C1 : 0;
+
+    // min exponent is zero or denormal; pseudo-denormals count as denormal
+    if (src.isminexp())
+        return result | ((src.m_mantissa == 0) ? X87SW_C3 : (X87SW_C3 | X87SW_C2));
+
+    // anything else without the explicit one is unsupported
+    if ((src.m_mantissa & FP80_EXPLICIT_ONE) == 0)
+        return result;
+
+    // max exponent is infinity or NaN
+    if (src.ismaxexp())
+        return result | (((src.m_mantissa & FP80_MANTISSA_MASK) == 0) ? (X87SW_C2 | X87SW_C0) : X87SW_C0);
+    return result | X87SW_C2;
+}
+
+
 //
 // x87 FLD for 80-bit sources
 // Exceptions: none
@@ -58,6 +58,7 @@ namespace x87
 {
 
 struct fp64_t;
+class fp80_array_view_t;
 
 //
 // packing needed to get this to come out as 10 bytes; most compilers will
@@ -76,8 +77,8 @@ public:
     // construction/destruction
     //
     explicit fp80_t() { }
-    explicit fp80_t(uint64_t man, uint16_t se) : m_mantissa(man), m_sign_exp(se) { }
-    fp80_t(fp80_t const &v80) : m_mantissa(v80.m_mantissa), m_sign_exp(v80.m_sign_exp) { }
+    constexpr explicit fp80_t(uint64_t man, uint16_t se) : m_mantissa(man), m_sign_exp(se) { }
+    constexpr fp80_t(fp80_t const &v80) : m_mantissa(v80.m_mantissa), m_sign_exp(v80.m_sign_exp) { }
     explicit fp80_t(fp64_t const &v64) { x87sw_t sw; this->x87_fld64(fpround_t::get(), sw, *this, &v64); }
     explicit fp80_t(double _val) { x87sw_t sw; this->x87_fld64(fpround_t::get(), sw, *this, &_val); }
     explicit fp80_t(float _val) { x87sw_t sw; this->x87_fld32(fpround_t::get(), sw, *this, &_val); }
@@ -142,19 +143,19 @@ public:
     //
     // static constants
     //
-    static fp80_t const_zero()  { static fp80_t const c(0x0000000000000000, 0x0000); return c; }
-    static fp80_t const_nzero() { static fp80_t const c(0x0000000000000000, 0x8000); return c; }
-    static fp80_t const_one()   { static fp80_t const c(0x8000000000000000, 0x3fff); return c; }
-    static fp80_t const_l2t()   { static fp80_t const c(0xd49a784bcd1b8afe, 0x4000); return c; }
-    static fp80_t const_l2e()   { static fp80_t const c(0xb8aa3b295c17f0bc, 0x3fff); return c; }
-    static fp80_t const_pi()    { static fp80_t const c(0xc90fdaa22168c235, 0x4000); return c; }
-    static fp80_t const_lg2()   { static fp80_t const c(0x9a209a84fbcff799, 0x3ffd); return c; }
-    static fp80_t const_ln2()   { static fp80_t const c(0xb17217f7d1cf79ac, 0x3ffe); return c; }
-    static fp80_t const_snan()  { static fp80_t const c(0x8000000000000001, 0x7fff); return c; }
-    static fp80_t const_qnan()  { static fp80_t const c(0xc000000000000001, 0x7fff); return c; }
-    static fp80_t const_pinf()  { static fp80_t const c(0x8000000000000000, 0x7fff); return c; }
-    static fp80_t const_ninf()  { static fp80_t const c(0x8000000000000000, 0xffff); return c; }
-    static fp80_t const_indef() { static fp80_t const c(0xc000000000000000, 0xffff); return c; }
+    static constexpr fp80_t const_zero()  { return fp80_t(0x0000000000000000, 0x0000); }
+    static constexpr fp80_t const_nzero() { return fp80_t(0x0000000000000000, 0x8000); }
+    static constexpr fp80_t const_one()   { return fp80_t(0x8000000000000000, 0x3fff); }
+    static constexpr fp80_t const_l2t()   { return fp80_t(0xd49a784bcd1b8afe, 0x4000); }
+    static constexpr fp80_t const_l2e()   { return fp80_t(0xb8aa3b295c17f0bc, 0x3fff); }
+    static constexpr fp80_t const_pi()    { return fp80_t(0xc90fdaa22168c235, 0x4000); }
+    static constexpr fp80_t const_lg2()   { return fp80_t(0x9a209a84fbcff799, 0x3ffd); }
+    static constexpr fp80_t const_ln2()   { return fp80_t(0xb17217f7d1cf79ac, 0x3ffe); }
+    static constexpr fp80_t const_snan()  { return fp80_t(0x8000000000000001, 0x7fff); }
+    static constexpr fp80_t const_qnan()  { return fp80_t(0xc000000000000001, 0x7fff); }
+    static constexpr fp80_t const_pinf()  { return fp80_t(0x8000000000000000, 0x7fff); }
+    static constexpr fp80_t const_ninf()  { return fp80_t(0x8000000000000000, 0xffff); }
+    static constexpr fp80_t const_indef() { return fp80_t(0xc000000000000000, 0xffff); }
 
     //
     // static unary ops
@@ -173,6 +174,7 @@ public:
     //
     // x87 ops
     //
+    static uint16_t x87_fxam(fp80_t const &src);
     // NYI static uint16_t x87_fxtract(fp80_t const &src, fp80_t &dst1, fp80_t &dst2);
     // NYI static uint16_t x87_fscale(fp80_t const &src1, fp80_t const &src2, fp80_t &dst);
     // NYI static uint16_t x87_fprem(fp80_t const &src1, fp80_t const &src2, fp80_t &dst);
@@ -194,6 +196,16 @@ public:
     static void x87_fld64(x87cw_t cw, x87sw_t &sw, fp80_t &dst, void const *src) { x87_fld_common<uint64_t>(cw, sw, dst, src); }
     static void x87_fld32(x87cw_t cw, x87sw_t &sw, fp80_t &dst, void const *src) { x87_fld_common<uint32_t>(cw, sw, dst, src); }
 
+    //
+    // floating point batch load helpers; flags are accumulated across all values
+    //
+    template<typename Type> static void x87_fld_batch(x87cw_t cw, x87sw_t &sw, fp80_t *dst, void const *src, size_t count);
+    static void x87_fld64_batch(x87cw_t cw, x87sw_t &sw, fp80_t *dst, void const *src, size_t count) { x87_fld_batch<uint64_t>(cw, sw, dst, src, count); }
+    static void x87_fld32_batch(x87cw_t cw, x87sw_t &sw, fp80_t *dst, void const *src, size_t count) { x87_fld_batch<uint32_t>(cw, sw, dst, src, count); }
+    template<typename Type> static void x87_fld_batch(x87cw_t cw, x87sw_t &sw, fp80_array_view_t const &dst, void const *src);
+    static void x87_fld64_batch(x87cw_t cw, x87sw_t &sw, fp80_array_view_t const &dst, void const *src) { x87_fld_batch<uint64_t>(cw, sw, dst, src); }
+    static void x87_fld32_batch(x87cw_t cw, x87sw_t &sw, fp80_array_view_t const &dst, void const *src) { x87_fld_batch<uint32_t>(cw, sw, dst, src); }
+
     //
     // integral load helpers
     //
@@ -202,6 +214,23 @@ public:
     static void x87_fild32(x87cw_t cw, x87sw_t &sw, fp80_t &dst, void const *src) { x87_fild_common<int32_t>(cw, sw, dst, src); }
     static void x87_fild16(x87cw_t cw, x87sw_t &sw, fp80_t &dst, void const *src) { x87_fild_common<int16_t>(cw, sw, dst, src); }
 
+    //
+    // integral batch load helpers; the fp64_t forms produce the same result as
+    // storing the fp80_t result with x87_fst64, but don't alter the flags
+    //
+    template<typename Type> static void x87_fild_batch(x87cw_t cw, x87sw_t &sw, fp80_t *dst, void const *src, size_t count);
+    template<typename Type> static void x87_fild_batch(x87cw_t cw, x87sw_t &sw, fp64_t *dst, void const *src, size_t count);
+    static void x87_fild64_batch(x87cw_t cw, x87sw_t &sw, fp80_t *dst, void const *src, size_t count) { x87_fild_batch<int64_t>(cw, sw, dst, src, count); }
+    static void x87_fild32_batch(x87cw_t cw, x87sw_t &sw, fp80_t *dst, void const *src, size_t count) { x87_fild_batch<int32_t>(cw, sw, dst, src, count); }
+    static void x87_fild16_batch(x87cw_t cw, x87sw_t &sw, fp80_t *dst, void const *src, size_t count) { x87_fild_batch<int16_t>(cw, sw, dst, src, count); }
+    template<typename Type> static void x87_fild_batch(x87cw_t cw, x87sw_t &sw, fp80_array_view_t const &dst, void const *src);
+    static void x87_fild64_batch(x87cw_t cw, x87sw_t &sw, fp80_array_view_t const &dst, void const *src) { x87_fild_batch<int64_t>(cw, sw, dst, src); }
+    static void x87_fild32_batch(x87cw_t cw, x87sw_t &sw, fp80_array_view_t const &dst, void const *src) { x87_fild_batch<int32_t>(cw, sw, dst, src); }
+    static void x87_fild16_batch(x87cw_t cw, x87sw_t &sw, fp80_array_view_t const &dst, void const *src) { x87_fild_batch<int16_t>(cw, sw, dst, src); }
+    static void x87_fild64_batch(x87cw_t cw, x87sw_t &sw, fp64_t *dst, void const *src, size_t count) { x87_fild_batch<int64_t>(cw, sw, dst, src, count); }
+    static void x87_fild32_batch(x87cw_t cw, x87sw_t &sw, fp64_t *dst, void const *src, size_t count) { x87_fild_batch<int32_t>(cw, sw, dst, src, count); }
+    static void x87_fild16_batch(x87cw_t cw, x87sw_t &sw, fp64_t *dst, void const *src, size_t count) { x87_fild_batch<int16_t>(cw, sw, dst, src, count); }
+
     //
     // floating point store helpers
     //
@@ -210,6 +239,16 @@ public:
     static void x87_fst64(x87cw_t cw, x87sw_t &sw, void *dst, fp80_t const &src) { x87_fst_common<uint64_t>(cw, sw, dst, src); }
     static void x87_fst32(x87cw_t cw, x87sw_t &sw, void *dst, fp80_t const &src) { x87_fst_common<uint32_t>(cw, sw, dst, src); }
 
+    //
+    // floating point batch store helpers; flags are accumulated across all values
+    //
+    template<typename Type> static void x87_fst_batch(x87cw_t cw, x87sw_t &sw, void *dst, fp80_t const *src, size_t count);
+    static void x87_fst64_batch(x87cw_t cw, x87sw_t &sw, void *dst, fp80_t const *src, size_t count) { x87_fst_batch<uint64_t>(cw, sw, dst, src, count); }
+    static void x87_fst32_batch(x87cw_t cw, x87sw_t &sw, void *dst, fp80_t const *src, size_t count) { x87_fst_batch<uint32_t>(cw, sw, dst, src, count); }
+    template<typename Type> static void x87_fst_batch(x87cw_t cw, x87sw_t &sw, void *dst, fp80_array_view_t const &src);
+    static void x87_fst64_batch(x87cw_t cw, x87sw_t &sw, void *dst, fp80_array_view_t const &src) { x87_fst_batch<uint64_t>(cw, sw, dst, src); }
+    static void x87_fst32_batch(x87cw_t cw, x87sw_t &sw, void *dst, fp80_array_view_t const &src) { x87_fst_batch<uint32_t>(cw, sw, dst, src); }
+
     //
     // integral store helpers
     //
@@ -218,6 +257,24 @@ public:
     static void x87_fist32(x87cw_t cw, x87sw_t &sw, void *dst, fp80_t const &src) { x87_fist_common<int32_t>(cw, sw, dst, src); }
     static void x87_fist16(x87cw_t cw, x87sw_t &sw, void *dst, fp80_t const &src) { x87_fist_common<int16_t>(cw, sw, dst, src); }
 
+    //
+    // integral batch store helpers; flags are accumulated across all values
+    //
+    template<typename Type> static void x87_fist_batch(x87cw_t cw, x87sw_t &sw, void *dst, fp80_t const *src, size_t count);
+    static void x87_fist64_batch(x87cw_t cw, x87sw_t &sw, void *dst, fp80_t const *src, size_t count) { x87_fist_batch<int64_t>(cw, sw, dst, src, count); }
+    static void x87_fist32_batch(x87cw_t cw, x87sw_t &sw, void *dst, fp80_t const *src, size_t count) { x87_fist_batch<int32_t>(cw, sw, dst, src, count); }
+    static void x87_fist16_batch(x87cw_t cw, x87sw_t &sw, void *dst, fp80_t const *src, size_t count) { x87_fist_batch<int16_t>(cw, sw, dst, src, count); }
+    template<typename Type> static void x87_fist_batch(x87cw_t cw, x87sw_t &sw, void *dst, fp80_array_view_t const &src);
+    static void x87_fist64_batch(x87cw_t cw, x87sw_t &sw, void *dst, fp80_array_view_t const &src) { x87_fist_batch<int64_t>(cw, sw, dst, src); }
+    static void x87_fist32_batch(x87cw_t cw, x87sw_t &sw, void *dst, fp80_array_view_t const &src) { x87_fist_batch<int32_t>(cw, sw, dst, src); }
+    static void x87_fist16_batch(x87cw_t cw, x87sw_t &sw, void *dst, fp80_array_view_t const &src) { x87_fist_batch<int16_t>(cw, sw, dst, src); }
+
+    //
+    // batch FXAM; writes the condition codes for each value
+    //
+    static void x87_fxam_batch(fp80_t const *src, uint16_t *dst, size_t count);
+    static void x87_fxam_batch(fp80_array_view_t const &src, uint16_t *dst);
+
     //
     // static misc ops
     //
@@ -0,0 +1,184 @@
+//=========================================================
+//  x87fp80array.h
+//
+//  Structure-of-arrays container for bulk 80-bit values.
+//=========================================================
+//
+// BSD 3-Clause License
+//
+// Copyright (c) 2025, Aaron Giles
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+
+#pragma once
+
+#ifndef X87FP80ARRAY_H
+#define X87FP80ARRAY_H
+
+#include <new>
+
+#include "x87fp80.h"
+
+
+//===========================================================================
+//
+// x87::fp80_array_view_t
+// x87::fp80_array_t
+//
+// Arrays of fp80_t values stored as two separate streams: one of 64-bit
+// mantissas and one of 16-bit sign/exponents. Unlike packed 10-byte fp80_t
+// records, each stream can be read and written with full-width vector
+// loads and stores, so this is the preferred form for bulk 80-bit work.
+//
+// fp80_array_view_t is a non-owning view over a pair of existing streams
+// (for example, an emulator's register file or memory that is already kept
+// split), and is what the batch helpers accept. fp80_array_t owns its
+// storage, aligned to a cache line, and can be passed anywhere a view is
+// expected.
+//
+//===========================================================================
+
+namespace x87
+{
+
+//
+// non-owning view over separate mantissa and sign/exponent streams
+//
+class fp80_array_view_t
+{
+public:
+    //
+    // construction/destruction
+    //
+    constexpr fp80_array_view_t() : m_mantissa(nullptr), m_sign_exp(nullptr), m_count(0) { }
+    constexpr fp80_array_view_t(uint64_t *mantissa, uint16_t *sign_exp, size_t count) : m_mantissa(mantissa), m_sign_exp(sign_exp), m_count(count) { }
+
+    //
+    // accessors
+    //
+    size_t size() const { return m_count; }
+    uint64_t *mantissa() const { return m_mantissa; }
+    uint16_t *sign_exp() const { return m_sign_exp; }
+
+    //
+    // element access
+    //
+    fp80_t get(size_t index) const { return fp80_t(m_mantissa[index], m_sign_exp[index]); }
+    void set(size_t index, fp80_t const &value) const { m_mantissa[index] = value.mantissa(); m_sign_exp[index] = value.sign_exp(); }
+
+    //
+    // return a view of count values starting at the given index
+    //
+    fp80_array_view_t subview(size_t start, size_t count) const { return fp80_array_view_t(m_mantissa + start, m_sign_exp + start, count); }
+
+    //
+    // conversion to/from packed fp80_t arrays of the same size; these are
+    // plain copies that don't interpret the values
+    //
+    void pack(fp80_t *dst) const;
+    void unpack(fp80_t const *src) const;
+
+protected:
+    //
+    // internal state
+    //
+    uint64_t *m_mantissa;
+    uint16_t *m_sign_exp;
+    size_t m_count;
+};
+
+
+//
+// owning container; both streams live in a single allocation, with the
+// sign/exponent stream following the mantissas at the next aligned offset
+//
+class fp80_array_t : public fp80_array_view_t
+{
+    static constexpr size_t ALIGNMENT = 64;
+
+public:
+    //
+    // construction/destruction
+    //
+    fp80_array_t() { }
+    explicit fp80_array_t(size_t count) { allocate(count); }
+    fp80_array_t(fp80_t const *src, size_t count) { allocate(count); unpack(src); }
+    fp80_array_t(fp80_array_t &&src) : fp80_array_view_t(src) { static_cast<fp80_array_view_t &>(src) = fp80_array_view_t(); }
+    fp80_array_t(fp80_array_t const &src) = delete;
+    ~fp80_array_t() { release(); }
+
+    //
+    // operators
+    //
+    fp80_array_t &operator=(fp80_array_t const &src) = delete;
+    fp80_array_t &operator=(fp80_array_t &&src)
+    {
+        if (this != &src)
+        {
+            release();
+            static_cast<fp80_array_view_t &>(*this) = src;
+            static_cast<fp80_array_view_t &>(src) = fp80_array_view_t();
+        }
+        return *this;
+    }
+
+    //
+    // return a view of the whole array
+    //
+    fp80_array_view_t view() const { return *this; }
+
+private:
+    //
+    // allocate storage for count values
+    //
+    void allocate(size_t count)
+    {
+        if (count == 0)
+            return;
+        size_t mantissa_bytes = (count * sizeof(uint64_t) + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+        size_t sign_exp_bytes = (count * sizeof(uint16_t) + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+        auto *base = static_cast<uint8_t *>(::operator new(mantissa_bytes + sign_exp_bytes, std::align_val_t(ALIGNMENT)));
+        m_mantissa = reinterpret_cast<uint64_t *>(base);
+        m_sign_exp = reinterpret_cast<uint16_t *>(base + mantissa_bytes);
+        m_count = count;
+    }
+
+    //
+    // free any allocated storage
+    //
+    void release()
+    {
+        if (m_mantissa != nullptr)
+            ::operator delete(m_mantissa, std::align_val_t(ALIGNMENT));
+        static_cast<fp80_array_view_t &>(*this) = fp80_array_view_t();
+    }
+};
+
+}
+
+#endif
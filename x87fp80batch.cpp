@@ -0,0 +1,915 @@
+//=========================================================
+//  x87fp80batch.cpp
+//
+//  80-bit floating-point batch load/store support
+//=========================================================
+//
+// BSD 3-Clause License
+//
+// Copyright (c) 2025, Aaron Giles
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include <cstdint>
+#include <type_traits>
+
+#include "x87fp80.h"
+#include "x87fp64.h"
+#include "x87fp80array.h"
+#include "x87simd.h"
+
+//
+// The batch helpers in this file produce results and flags identical to
+// calling the equivalent scalar helper on each element in turn, with flags
+// accumulated across the whole batch. Source and destination must not
+// overlap.
+//
+// The fp80_t side of each helper can be either a packed array of fp80_t or
+// an fp80_array_view_t; the latter allows full-width vector loads and
+// stores instead of shuffling 10-byte records.
+//
+// SIMD versions work on groups of 4 values; any lanes that contain values
+// needing special handling (NaNs, infinities, denormals, etc) are simply
+// recomputed afterwards by the scalar helper, which is also used for any
+// leftover values at the end.
+//
+
+namespace x87
+{
+
+//===========================================================================
+//
+// Element access
+//
+//===========================================================================
+
+//
+// scalar access to a single value in either a packed array or a split view
+//
+inline fp80_t get_fp80(fp80_t const *src, size_t index) { return src[index]; }
+inline fp80_t get_fp80(fp80_array_view_t const &src, size_t index) { return src.get(index); }
+inline void set_fp80(fp80_t *dst, size_t index, fp80_t const &value) { dst[index] = value; }
+inline void set_fp80(fp80_array_view_t const &dst, size_t index, fp80_t const &value) { dst.set(index, value); }
+
+#if X87_SIMD_X64
+
+//===========================================================================
+//
+// AVX2 helpers
+//
+//===========================================================================
+
+//
+// load 4 fp80_t values and split them into separate mantissa and sign/exponent
+// lanes; each record is fetched with a 16-byte load, except for the last one,
+// which is loaded from 6 bytes earlier and shifted down so as not to read
+// past the end
+//
+X87_TARGET_AVX2 inline void load_fp80x4(fp80_t const *src, size_t index, __m256i &mantissa, __m256i &sign_exp)
+{
+    auto const *base = reinterpret_cast<uint8_t const *>(&src[index]);
+    __m128i rec0 = _mm_loadu_si128(reinterpret_cast<__m128i const *>(base + 0));
+    __m128i rec1 = _mm_loadu_si128(reinterpret_cast<__m128i const *>(base + 10));
+    __m128i rec2 = _mm_loadu_si128(reinterpret_cast<__m128i const *>(base + 20));
+    __m128i rec3 = _mm_srli_si128(_mm_loadu_si128(reinterpret_cast<__m128i const *>(base + 24)), 6);
+
+    mantissa = _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_unpacklo_epi64(rec0, rec1)), _mm_unpacklo_epi64(rec2, rec3), 1);
+    sign_exp = _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_unpackhi_epi64(rec0, rec1)), _mm_unpackhi_epi64(rec2, rec3), 1);
+    sign_exp = _mm256_and_si256(sign_exp, _mm256_set1_epi64x(0xffff));
+}
+
+//
+// load 4 values from a split view; no shuffling required
+//
+X87_TARGET_AVX2 inline void load_fp80x4(fp80_array_view_t const &src, size_t index, __m256i &mantissa, __m256i &sign_exp)
+{
+    mantissa = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(&src.mantissa()[index]));
+    sign_exp = _mm256_cvtepu16_epi64(_mm_loadl_epi64(reinterpret_cast<__m128i const *>(&src.sign_exp()[index])));
+}
+
+//
+// store the low 64, 32, or 16 bits of each of 4 64-bit lanes
+//
+template<typename Type>
+X87_TARGET_AVX2 inline void store_narrow_x4(Type *dst, __m256i value)
+{
+    if constexpr (sizeof(Type) == 8)
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst), value);
+    else
+    {
+        __m128i packed = _mm256_castsi256_si128(_mm256_permutevar8x32_epi32(value, _mm256_setr_epi32(0, 2, 4, 6, 1, 3, 5, 7)));
+        if constexpr (sizeof(Type) == 4)
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(dst), packed);
+        else
+            _mm_storel_epi64(reinterpret_cast<__m128i *>(dst), _mm_shuffle_epi8(packed, _mm_setr_epi8(0, 1, 4, 5, 8, 9, 12, 13, -1, -1, -1, -1, -1, -1, -1, -1)));
+    }
+}
+
+//
+// store 4 fp80_t values from separate mantissa and sign/exponent lanes; each
+// record is written with a 16-byte store whose 6 extra bytes are overwritten
+// by the following record, and the final record is assembled together with
+// the tail of the previous one so that we never write past the end
+//
+X87_TARGET_AVX2 inline void store_fp80x4(fp80_t *dst, size_t index, __m256i mantissa, __m256i sign_exp)
+{
+    __m128i manlo = _mm256_castsi256_si128(mantissa);
+    __m128i manhi = _mm256_extracti128_si256(mantissa, 1);
+    __m128i selo = _mm256_castsi256_si128(sign_exp);
+    __m128i sehi = _mm256_extracti128_si256(sign_exp, 1);
+    __m128i rec2 = _mm_unpacklo_epi64(manhi, sehi);
+    __m128i rec3 = _mm_unpackhi_epi64(manhi, sehi);
+
+    auto *base = reinterpret_cast<uint8_t *>(&dst[index]);
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(base + 0), _mm_unpacklo_epi64(manlo, selo));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(base + 10), _mm_unpackhi_epi64(manlo, selo));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(base + 20), rec2);
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(base + 24), _mm_or_si128(_mm_srli_si128(rec2, 4), _mm_slli_si128(rec3, 6)));
+}
+
+//
+// store 4 values to a split view
+//
+X87_TARGET_AVX2 inline void store_fp80x4(fp80_array_view_t const &dst, size_t index, __m256i mantissa, __m256i sign_exp)
+{
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(&dst.mantissa()[index]), mantissa);
+    store_narrow_x4(&dst.sign_exp()[index], sign_exp);
+}
+
+#endif
+
+
+
+//===========================================================================
+//
+// x87_fld_batch
+//
+// Batch FLD for 64-bit or 32-bit floating-point sources.
+//
+//===========================================================================
+
+//
+// scalar version
+//
+template<typename Type, typename ArrayType>
+static void fld_batch_scalar(x87cw_t cw, x87sw_t &sw, ArrayType dst, Type const *src, size_t index, size_t count)
+{
+    for ( ; index < count; index++)
+    {
+        fp80_t result;
+        fp80_t::x87_fld_common<Type>(cw, sw, result, &src[index]);
+        set_fp80(dst, index, result);
+    }
+}
+
+#if X87_SIMD_X64
+
+//
+// AVX2 version: every normal value converts with a handful of shifts and
+// masks; zero/denormal and infinite/NaN sources are the only ones that
+// can set flags, so those lanes are redone by the scalar helper
+//
+template<typename Type, typename ArrayType>
+X87_TARGET_AVX2 static void fld_batch_avx2(x87cw_t cw, x87sw_t &sw, ArrayType dst, Type const *src, size_t count)
+{
+    // select source parameters based on incoming type
+    constexpr int SRC_EXPONENT_SHIFT = (sizeof(Type) == 8) ? FP64_EXPONENT_SHIFT : FP32_EXPONENT_SHIFT;
+    constexpr int SRC_SIGN_SHIFT = (sizeof(Type) == 8) ? FP64_SIGN_SHIFT : FP32_SIGN_SHIFT;
+    constexpr int32_t SRC_EXPONENT_BIAS = (sizeof(Type) == 8) ? FP64_EXPONENT_BIAS : FP32_EXPONENT_BIAS;
+    constexpr int32_t SRC_EXPONENT_MAX_BIASED = (sizeof(Type) == 8) ? FP64_EXPONENT_MAX_BIASED : FP32_EXPONENT_MAX_BIASED;
+
+    __m256i const expmask = _mm256_set1_epi64x(SRC_EXPONENT_MAX_BIASED);
+    __m256i const zero = _mm256_setzero_si256();
+    __m256i const explicit_one = _mm256_set1_epi64x(FP80_EXPLICIT_ONE);
+    __m256i const signmask = _mm256_set1_epi64x(FP80_SIGN_MASK);
+    __m256i const rebias = _mm256_set1_epi64x(FP80_EXPONENT_BIAS - SRC_EXPONENT_BIAS);
+
+    size_t index = 0;
+    for ( ; index + 4 <= count; index += 4)
+    {
+        // load 4 values, zero-extended into 64-bit lanes
+        __m256i raw;
+        if constexpr (sizeof(Type) == 8)
+            raw = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(&src[index]));
+        else
+            raw = _mm256_cvtepu32_epi64(_mm_loadu_si128(reinterpret_cast<__m128i const *>(&src[index])));
+
+        // extract exponent and flag the min/max exponent lanes as special
+        __m256i exponent = _mm256_and_si256(_mm256_srli_epi64(raw, SRC_EXPONENT_SHIFT), expmask);
+        __m256i special = _mm256_or_si256(_mm256_cmpeq_epi64(exponent, zero), _mm256_cmpeq_epi64(exponent, expmask));
+
+        // shift the mantissa into place; the explicit 1 overwrites any leftover exponent bit
+        __m256i mantissa = _mm256_or_si256(_mm256_slli_epi64(raw, 63 - SRC_EXPONENT_SHIFT), explicit_one);
+
+        // move the sign and insert the adjusted exponent
+        __m256i sign_exp = _mm256_and_si256(_mm256_srli_epi64(raw, SRC_SIGN_SHIFT - FP80_SIGN_SHIFT), signmask);
+        sign_exp = _mm256_or_si256(sign_exp, _mm256_add_epi64(exponent, rebias));
+        store_fp80x4(dst, index, mantissa, sign_exp);
+
+        // redo any special lanes with the scalar helper
+        for (uint32_t mask = _mm256_movemask_pd(_mm256_castsi256_pd(special)); mask != 0; mask &= mask - 1)
+        {
+            size_t lane = index + count_trailing_zeros64(mask);
+            fp80_t result;
+            fp80_t::x87_fld_common<Type>(cw, sw, result, &src[lane]);
+            set_fp80(dst, lane, result);
+        }
+    }
+
+    // handle any leftovers
+    fld_batch_scalar<Type>(cw, sw, dst, src, index, count);
+}
+
+#endif
+
+//
+// select the best version for the host
+//
+template<typename Type, typename ArrayType>
+static void fld_batch(x87cw_t cw, x87sw_t &sw, ArrayType dst, Type const *src, size_t count)
+{
+#if X87_SIMD_X64
+    if (host_has_avx2())
+        return fld_batch_avx2<Type>(cw, sw, dst, src, count);
+#endif
+    fld_batch_scalar<Type>(cw, sw, dst, src, 0, count);
+}
+
+//
+// entry points
+//
+template<typename Type>
+void fp80_t::x87_fld_batch(x87cw_t cw, x87sw_t &sw, fp80_t *dst, void const *src, size_t count)
+{
+    fld_batch<Type>(cw, sw, dst, static_cast<Type const *>(src), count);
+}
+template void fp80_t::x87_fld_batch<uint64_t>(x87cw_t cw, x87sw_t &sw, fp80_t *dst, void const *src, size_t count);
+template void fp80_t::x87_fld_batch<uint32_t>(x87cw_t cw, x87sw_t &sw, fp80_t *dst, void const *src, size_t count);
+
+template<typename Type>
+void fp80_t::x87_fld_batch(x87cw_t cw, x87sw_t &sw, fp80_array_view_t const &dst, void const *src)
+{
+    fld_batch<Type>(cw, sw, dst, static_cast<Type const *>(src), dst.size());
+}
+template void fp80_t::x87_fld_batch<uint64_t>(x87cw_t cw, x87sw_t &sw, fp80_array_view_t const &dst, void const *src);
+template void fp80_t::x87_fld_batch<uint32_t>(x87cw_t cw, x87sw_t &sw, fp80_array_view_t const &dst, void const *src);
+
+
+
+//===========================================================================
+//
+// x87_fst_batch
+//
+// Batch FST for 64-bit or 32-bit floating-point targets.
+//
+//===========================================================================
+
+//
+// scalar version
+//
+template<typename Type, typename ArrayType>
+static void fst_batch_scalar(x87cw_t cw, x87sw_t &sw, Type *dst, ArrayType src, size_t index, size_t count)
+{
+    for ( ; index < count; index++)
+        fp80_t::x87_fst_common<Type>(cw, sw, &dst[index], get_fp80(src, index));
+}
+
+#if X87_SIMD_X64
+
+//
+// convert 4 fp80_t values to 64-bit or 32-bit floating-point bits; the rounding
+// logic from round_in_place is applied to all lanes at once, since the
+// rounding mode is the same for the whole batch and only the direction of
+// directed rounding depends on the sign of each lane. Lanes holding zeros,
+// infinities/NaNs, or values that end up denormal or overflow in the target
+// format are returned in the special mask; PE/C1 for the remaining lanes are
+// returned in laneflags
+//
+template<typename Type>
+X87_TARGET_AVX2 inline __m256i fst_round_x4(x87cw_t rval, __m256i src_mantissa, __m256i src_sign_exp, __m256i &laneflags, __m256i &special)
+{
+    // determine target constants based on the template parameter size
+    constexpr int TARGET_SIGN_SHIFT = (sizeof(Type) == 8) ? FP64_SIGN_SHIFT : FP32_SIGN_SHIFT;
+    constexpr int TARGET_EXPONENT_SHIFT = (sizeof(Type) == 8) ? FP64_EXPONENT_SHIFT : FP32_EXPONENT_SHIFT;
+    constexpr int32_t TARGET_EXPONENT_BIAS = (sizeof(Type) == 8) ? FP64_EXPONENT_BIAS : FP32_EXPONENT_BIAS;
+    constexpr int32_t TARGET_EXPONENT_MAX_BIASED = (sizeof(Type) == 8) ? FP64_EXPONENT_MAX_BIASED : FP32_EXPONENT_MAX_BIASED;
+    constexpr int MANTISSA_SHIFT = 63 - TARGET_EXPONENT_SHIFT;
+
+    __m256i const zero = _mm256_setzero_si256();
+    __m256i const one = _mm256_set1_epi64x(1);
+    __m256i const mantmask = _mm256_set1_epi64x(FP80_MANTISSA_MASK);
+    __m256i const expmask = _mm256_set1_epi64x(FP80_EXPONENT_MASK);
+
+    // extract the pieces
+    __m256i sign = _mm256_srli_epi64(src_sign_exp, FP80_SIGN_SHIFT);
+    __m256i exponent = _mm256_and_si256(src_sign_exp, expmask);
+    __m256i orig_mantissa = _mm256_and_si256(src_mantissa, mantmask);
+
+    // infinities/NaNs and zeros are special
+    special = _mm256_or_si256(_mm256_cmpeq_epi64(exponent, expmask),
+        _mm256_and_si256(_mm256_cmpeq_epi64(exponent, zero), _mm256_cmpeq_epi64(orig_mantissa, zero)));
+
+    // apply rounding; for directed rounding, only lanes whose sign matches
+    // the rounding direction round away from zero
+    __m256i mantissa = orig_mantissa;
+    if (rval == X87CW_ROUNDING_NEAREST)
+    {
+        __m256i odd = _mm256_andnot_si256(_mm256_srli_epi64(_mm256_or_si256(mantissa, _mm256_set1_epi64x(FP80_EXPLICIT_ONE)), MANTISSA_SHIFT), one);
+        mantissa = _mm256_add_epi64(mantissa, _mm256_sub_epi64(_mm256_set1_epi64x(1ull << (MANTISSA_SHIFT - 1)), odd));
+    }
+    else if (rval != X87CW_ROUNDING_ZERO)
+    {
+        __m256i hardsign = _mm256_set1_epi64x((rval == X87CW_ROUNDING_DOWN) ? 1 : 0);
+        mantissa = _mm256_add_epi64(mantissa, _mm256_and_si256(_mm256_cmpeq_epi64(sign, hardsign), _mm256_set1_epi64x((1ull << MANTISSA_SHIFT) - 1)));
+    }
+
+    // on overflow, bump the exponent and clear the carry out
+    __m256i carry = _mm256_cmpgt_epi64(zero, mantissa);
+    exponent = _mm256_sub_epi64(exponent, carry);
+    mantissa = _mm256_and_si256(mantissa, mantmask);
+
+    // adjust exponent to the target bias; denormals and overflows are special
+    exponent = _mm256_add_epi64(exponent, _mm256_set1_epi64x(TARGET_EXPONENT_BIAS - FP80_EXPONENT_BIAS));
+    special = _mm256_or_si256(special, _mm256_cmpgt_epi64(one, exponent));
+    special = _mm256_or_si256(special, _mm256_cmpgt_epi64(exponent, _mm256_set1_epi64x(TARGET_EXPONENT_MAX_BIASED - 1)));
+
+    // set precision and C1 flags on inexact lanes
+    __m256i exact = _mm256_cmpeq_epi64(_mm256_and_si256(orig_mantissa, _mm256_set1_epi64x((1ull << MANTISSA_SHIFT) - 1)), zero);
+    laneflags = _mm256_and_si256(_mm256_srli_epi64(_mm256_xor_si256(orig_mantissa, mantissa), MANTISSA_SHIFT - X87SW_C1_BIT), _mm256_set1_epi64x(X87SW_C1));
+    laneflags = _mm256_andnot_si256(_mm256_or_si256(special, exact), _mm256_or_si256(laneflags, _mm256_set1_epi64x(X87SW_PRECISION_EX)));
+
+    // assemble the result
+    __m256i result = _mm256_or_si256(_mm256_slli_epi64(sign, TARGET_SIGN_SHIFT), _mm256_slli_epi64(exponent, TARGET_EXPONENT_SHIFT));
+    return _mm256_or_si256(result, _mm256_srli_epi64(mantissa, MANTISSA_SHIFT));
+}
+
+//
+// AVX2 version: special lanes are redone by the scalar helper
+//
+template<typename Type, typename ArrayType>
+X87_TARGET_AVX2 static void fst_batch_avx2(x87cw_t cw, x87sw_t &sw, Type *dst, ArrayType src, size_t count)
+{
+    x87cw_t rval = cw & X87CW_ROUNDING_MASK;
+    __m256i flags = _mm256_setzero_si256();
+    size_t index = 0;
+    for ( ; index + 4 <= count; index += 4)
+    {
+        __m256i mantissa, sign_exp, laneflags, special;
+        load_fp80x4(src, index, mantissa, sign_exp);
+        store_narrow_x4(&dst[index], fst_round_x4<Type>(rval, mantissa, sign_exp, laneflags, special));
+        flags = _mm256_or_si256(flags, laneflags);
+
+        // redo any special lanes with the scalar helper
+        for (uint32_t mask = _mm256_movemask_pd(_mm256_castsi256_pd(special)); mask != 0; mask &= mask - 1)
+        {
+            size_t lane = index + count_trailing_zeros64(mask);
+            fp80_t::x87_fst_common<Type>(cw, sw, &dst[lane], get_fp80(src, lane));
+        }
+    }
+    sw |= x87sw_t(reduce_or4(flags));
+
+    // handle any leftovers
+    fst_batch_scalar<Type>(cw, sw, dst, src, index, count);
+}
+
+#endif
+
+//
+// select the best version for the host
+//
+template<typename Type, typename ArrayType>
+static void fst_batch(x87cw_t cw, x87sw_t &sw, Type *dst, ArrayType src, size_t count)
+{
+#if X87_SIMD_X64
+    if (host_has_avx2())
+        return fst_batch_avx2<Type>(cw, sw, dst, src, count);
+#endif
+    fst_batch_scalar<Type>(cw, sw, dst, src, 0, count);
+}
+
+//
+// entry points
+//
+template<typename Type>
+void fp80_t::x87_fst_batch(x87cw_t cw, x87sw_t &sw, void *dst, fp80_t const *src, size_t count)
+{
+    fst_batch<Type>(cw, sw, static_cast<Type *>(dst), src, count);
+}
+template void fp80_t::x87_fst_batch<uint64_t>(x87cw_t cw, x87sw_t &sw, void *dst, fp80_t const *src, size_t count);
+template void fp80_t::x87_fst_batch<uint32_t>(x87cw_t cw, x87sw_t &sw, void *dst, fp80_t const *src, size_t count);
+
+template<typename Type>
+void fp80_t::x87_fst_batch(x87cw_t cw, x87sw_t &sw, void *dst, fp80_array_view_t const &src)
+{
+    fst_batch<Type>(cw, sw, static_cast<Type *>(dst), src, src.size());
+}
+template void fp80_t::x87_fst_batch<uint64_t>(x87cw_t cw, x87sw_t &sw, void *dst, fp80_array_view_t const &src);
+template void fp80_t::x87_fst_batch<uint32_t>(x87cw_t cw, x87sw_t &sw, void *dst, fp80_array_view_t const &src);
+
+
+
+//===========================================================================
+//
+// x87_fist_batch
+//
+// Batch FIST for 64-bit, 32-bit, or 16-bit integer targets.
+//
+//===========================================================================
+
+//
+// scalar version
+//
+template<typename Type, typename ArrayType>
+static void fist_batch_scalar(x87cw_t cw, x87sw_t &sw, Type *dst, ArrayType src, size_t index, size_t count)
+{
+    for ( ; index < count; index++)
+        fp80_t::x87_fist_common<Type>(cw, sw, &dst[index], get_fp80(src, index));
+}
+
+#if X87_SIMD_X64
+
+//
+// AVX2 version: each lane is classified the same way x87_fist_common does
+// it; in-range values are rounded using per-lane variable shifts, while
+// out-of-range/NaN/infinite lanes get the indefinite value and the small
+// (|x| < 1) and zero cases are blended in. The only lanes left to the scalar
+// helper are those at or rounding up to the magnitude limit of the target,
+// where just one of the two signs is representable
+//
+template<typename Type, typename ArrayType>
+X87_TARGET_AVX2 static void fist_batch_avx2(x87cw_t cw, x87sw_t &sw, Type *dst, ArrayType src, size_t count)
+{
+    constexpr int TARGET_BITS = 8 * sizeof(Type);
+
+    __m256i const zero = _mm256_setzero_si256();
+    __m256i const one = _mm256_set1_epi64x(1);
+    __m256i const mantmask = _mm256_set1_epi64x(FP80_MANTISSA_MASK);
+    __m256i const expmask = _mm256_set1_epi64x(FP80_EXPONENT_MASK);
+    __m256i const explicit_one = _mm256_set1_epi64x(FP80_EXPLICIT_ONE);
+    __m256i const shiftbase = _mm256_set1_epi64x(FP80_EXPONENT_BIAS + 63);
+    __m256i const edgeshift = _mm256_set1_epi64x(64 - TARGET_BITS);
+    __m256i const maxshift = _mm256_set1_epi64x(63);
+    __m256i const indefinite = _mm256_set1_epi64x(0x8000000000000000ll >> (64 - TARGET_BITS));
+    __m256i const invalid = _mm256_set1_epi64x(X87SW_INVALID_EX);
+    __m256i const precision = _mm256_set1_epi64x(X87SW_PRECISION_EX);
+    __m256i const c1 = _mm256_set1_epi64x(X87SW_C1);
+
+    // directed rounding only rounds away from zero for lanes whose sign matches hardsign
+    x87cw_t rval = cw & X87CW_ROUNDING_MASK;
+    __m256i const hardsign = _mm256_set1_epi64x((rval == X87CW_ROUNDING_DOWN) ? 1 : 0);
+
+    __m256i flags = zero;
+    size_t index = 0;
+    for ( ; index + 4 <= count; index += 4)
+    {
+        __m256i src_mantissa, src_sign_exp;
+        load_fp80x4(src, index, src_mantissa, src_sign_exp);
+
+        // extract the pieces
+        __m256i sign = _mm256_srli_epi64(src_sign_exp, FP80_SIGN_SHIFT);
+        __m256i negmask = _mm256_sub_epi64(zero, sign);
+        __m256i exponent = _mm256_and_si256(src_sign_exp, expmask);
+        __m256i orig_mantissa = _mm256_and_si256(src_mantissa, mantmask);
+        __m256i shift = _mm256_sub_epi64(shiftbase, exponent);
+
+        // classify the lanes
+        __m256i iszero = _mm256_and_si256(_mm256_cmpeq_epi64(exponent, zero), _mm256_cmpeq_epi64(orig_mantissa, zero));
+        __m256i isindef = _mm256_or_si256(_mm256_cmpeq_epi64(exponent, expmask), _mm256_cmpgt_epi64(edgeshift, shift));
+        __m256i special = _mm256_andnot_si256(isindef, _mm256_cmpeq_epi64(shift, edgeshift));
+        __m256i issmall = _mm256_andnot_si256(iszero, _mm256_cmpgt_epi64(shift, maxshift));
+
+        // apply rounding with per-lane shifts
+        __m256i mantissa = orig_mantissa;
+        if (rval == X87CW_ROUNDING_NEAREST)
+        {
+            __m256i half = _mm256_sllv_epi64(one, _mm256_sub_epi64(shift, one));
+            __m256i odd = _mm256_andnot_si256(_mm256_srlv_epi64(_mm256_or_si256(mantissa, explicit_one), shift), one);
+            mantissa = _mm256_add_epi64(mantissa, _mm256_sub_epi64(half, odd));
+        }
+        else if (rval != X87CW_ROUNDING_ZERO)
+        {
+            __m256i hard = _mm256_sub_epi64(_mm256_sllv_epi64(one, shift), one);
+            mantissa = _mm256_add_epi64(mantissa, _mm256_and_si256(_mm256_cmpeq_epi64(sign, hardsign), hard));
+        }
+
+        // on overflow, reduce the shift by one and clear the carry out; if that
+        // takes us to the edge, let the scalar code sort it out
+        __m256i carry = _mm256_cmpgt_epi64(zero, mantissa);
+        __m256i newshift = _mm256_add_epi64(shift, carry);
+        mantissa = _mm256_and_si256(mantissa, mantmask);
+        special = _mm256_or_si256(special, _mm256_andnot_si256(_mm256_or_si256(isindef, issmall), _mm256_cmpeq_epi64(newshift, edgeshift)));
+
+        // shift the result and set precision flags if we lost any bits
+        __m256i result = _mm256_srlv_epi64(_mm256_or_si256(mantissa, explicit_one), newshift);
+        __m256i exact = _mm256_cmpeq_epi64(_mm256_and_si256(orig_mantissa, _mm256_sub_epi64(_mm256_sllv_epi64(one, shift), one)), zero);
+        __m256i roundup = _mm256_xor_si256(_mm256_srlv_epi64(_mm256_or_si256(orig_mantissa, explicit_one), shift), result);
+        __m256i laneflags = _mm256_andnot_si256(exact, _mm256_or_si256(precision, _mm256_slli_epi64(_mm256_and_si256(roundup, one), X87SW_C1_BIT)));
+
+        // small values become 0 or +/-1 depending on the rounding mode
+        __m256i smallone = zero;
+        if (rval == X87CW_ROUNDING_NEAREST)
+            smallone = _mm256_andnot_si256(_mm256_cmpeq_epi64(orig_mantissa, zero), _mm256_cmpeq_epi64(shift, _mm256_add_epi64(maxshift, one)));
+        else if (rval != X87CW_ROUNDING_ZERO)
+            smallone = _mm256_cmpeq_epi64(sign, hardsign);
+        result = _mm256_blendv_epi8(result, _mm256_and_si256(smallone, one), issmall);
+        laneflags = _mm256_blendv_epi8(laneflags, _mm256_or_si256(precision, _mm256_and_si256(smallone, c1)), issmall);
+
+        // apply sign, then blend in zeros and indefinites
+        result = _mm256_sub_epi64(_mm256_xor_si256(result, negmask), negmask);
+        result = _mm256_andnot_si256(iszero, result);
+        laneflags = _mm256_andnot_si256(iszero, laneflags);
+        result = _mm256_blendv_epi8(result, indefinite, isindef);
+        laneflags = _mm256_blendv_epi8(laneflags, invalid, isindef);
+
+        // accumulate flags and store
+        flags = _mm256_or_si256(flags, _mm256_andnot_si256(special, laneflags));
+        store_narrow_x4(&dst[index], result);
+
+        // redo any special lanes with the scalar helper
+        for (uint32_t mask = _mm256_movemask_pd(_mm256_castsi256_pd(special)); mask != 0; mask &= mask - 1)
+        {
+            size_t lane = index + count_trailing_zeros64(mask);
+            fp80_t::x87_fist_common<Type>(cw, sw, &dst[lane], get_fp80(src, lane));
+        }
+    }
+    sw |= x87sw_t(reduce_or4(flags));
+
+    // handle any leftovers
+    fist_batch_scalar<Type>(cw, sw, dst, src, index, count);
+}
+
+#endif
+
+//
+// select the best version for the host
+//
+template<typename Type, typename ArrayType>
+static void fist_batch(x87cw_t cw, x87sw_t &sw, Type *dst, ArrayType src, size_t count)
+{
+#if X87_SIMD_X64
+    if (host_has_avx2())
+        return fist_batch_avx2<Type>(cw, sw, dst, src, count);
+#endif
+    fist_batch_scalar<Type>(cw, sw, dst, src, 0, count);
+}
+
+//
+// entry points
+//
+template<typename Type>
+void fp80_t::x87_fist_batch(x87cw_t cw, x87sw_t &sw, void *dst, fp80_t const *src, size_t count)
+{
+    fist_batch<Type>(cw, sw, static_cast<Type *>(dst), src, count);
+}
+template void fp80_t::x87_fist_batch<int64_t>(x87cw_t cw, x87sw_t &sw, void *dst, fp80_t const *src, size_t count);
+template void fp80_t::x87_fist_batch<int32_t>(x87cw_t cw, x87sw_t &sw, void *dst, fp80_t const *src, size_t count);
+template void fp80_t::x87_fist_batch<int16_t>(x87cw_t cw, x87sw_t &sw, void *dst, fp80_t const *src, size_t count);
+
+template<typename Type>
+void fp80_t::x87_fist_batch(x87cw_t cw, x87sw_t &sw, void *dst, fp80_array_view_t const &src)
+{
+    fist_batch<Type>(cw, sw, static_cast<Type *>(dst), src, src.size());
+}
+template void fp80_t::x87_fist_batch<int64_t>(x87cw_t cw, x87sw_t &sw, void *dst, fp80_array_view_t const &src);
+template void fp80_t::x87_fist_batch<int32_t>(x87cw_t cw, x87sw_t &sw, void *dst, fp80_array_view_t const &src);
+template void fp80_t::x87_fist_batch<int16_t>(x87cw_t cw, x87sw_t &sw, void *dst, fp80_array_view_t const &src);
+
+
+//===========================================================================
+//
+// x87_fild_batch
+//
+// Batch FILD for 64-bit, 32-bit, or 16-bit integer sources, producing either
+// fp80_t values or fp64_t values rounded per the control word.
+//
+//===========================================================================
+
+//
+// scalar version
+//
+template<typename Type, typename ArrayType>
+static void fild_batch_scalar(x87cw_t cw, x87sw_t &sw, ArrayType dst, Type const *src, size_t index, size_t count)
+{
+    for ( ; index < count; index++)
+    {
+        fp80_t result;
+        fp80_t::x87_fild_common<Type>(cw, sw, result, &src[index]);
+        if constexpr (std::is_same_v<ArrayType, fp64_t *>)
+        {
+            x87sw_t dummy = 0;
+            fp80_t::x87_fst64(cw, dummy, &dst[index], result);
+        }
+        else
+            set_fp80(dst, index, result);
+    }
+}
+
+#if X87_SIMD_X64
+
+//
+// load 4 integers, sign-extended to 64 bits
+//
+template<typename Type>
+X87_TARGET_AVX2 inline __m256i load_int_x4(Type const *src)
+{
+    if constexpr (sizeof(Type) == 8)
+        return _mm256_loadu_si256(reinterpret_cast<__m256i const *>(src));
+    else if constexpr (sizeof(Type) == 4)
+        return _mm256_cvtepi32_epi64(_mm_loadu_si128(reinterpret_cast<__m128i const *>(src)));
+    else
+        return _mm256_cvtepi16_epi64(_mm_loadl_epi64(reinterpret_cast<__m128i const *>(src)));
+}
+
+//
+// finish converting 4 integers given their sign masks, absolute values, and
+// leading zero counts, storing either fp80_t or rounded fp64_t results;
+// zero lanes come out as +0
+//
+template<typename ArrayType>
+X87_TARGET_AVX2 inline void fild_store_x4(x87cw_t rval, ArrayType dst, size_t index, __m256i negmask, __m256i absval, __m256i clz)
+{
+    __m256i nonzero = _mm256_xor_si256(_mm256_cmpeq_epi64(absval, _mm256_setzero_si256()), _mm256_set1_epi64x(-1));
+    __m256i mantissa = _mm256_sllv_epi64(absval, clz);
+    __m256i sign_exp = _mm256_or_si256(_mm256_and_si256(negmask, _mm256_set1_epi64x(FP80_SIGN_MASK)), _mm256_sub_epi64(_mm256_set1_epi64x(FP80_EXPONENT_BIAS + 63), clz));
+    if constexpr (std::is_same_v<ArrayType, fp64_t *>)
+    {
+        // only zeros are special here, since integers can't overflow or go denormal
+        __m256i laneflags, special;
+        __m256i result = fst_round_x4<uint64_t>(rval, mantissa, sign_exp, laneflags, special);
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(&dst[index]), _mm256_and_si256(result, nonzero));
+    }
+    else
+        store_fp80x4(dst, index, mantissa, _mm256_and_si256(sign_exp, nonzero));
+}
+
+//
+// 32-bit and 16-bit integers are exactly representable as doubles, so they
+// can be converted directly in any rounding mode
+//
+template<typename Type>
+X87_TARGET_AVX2 inline void fild_fp64_small_x4(fp64_t *dst, Type const *src)
+{
+    __m128i value;
+    if constexpr (sizeof(Type) == 4)
+        value = _mm_loadu_si128(reinterpret_cast<__m128i const *>(src));
+    else
+        value = _mm_cvtepi16_epi32(_mm_loadl_epi64(reinterpret_cast<__m128i const *>(src)));
+    _mm256_storeu_pd(reinterpret_cast<double *>(dst), _mm256_cvtepi32_pd(value));
+}
+
+//
+// AVX2 version: leading zeros are counted with clz_x4_avx2; FILD never sets
+// any flags, so no lanes need to be redone
+//
+template<typename Type, typename ArrayType>
+X87_TARGET_AVX2 static void fild_batch_avx2(x87cw_t cw, x87sw_t &sw, ArrayType dst, Type const *src, size_t count)
+{
+    x87cw_t rval = cw & X87CW_ROUNDING_MASK;
+    size_t index = 0;
+    for ( ; index + 4 <= count; index += 4)
+    {
+        if constexpr (std::is_same_v<ArrayType, fp64_t *> && sizeof(Type) != 8)
+            fild_fp64_small_x4(&dst[index], &src[index]);
+        else
+        {
+            __m256i raw = load_int_x4(&src[index]);
+            __m256i negmask = _mm256_cmpgt_epi64(_mm256_setzero_si256(), raw);
+            __m256i absval = _mm256_sub_epi64(_mm256_xor_si256(raw, negmask), negmask);
+            fild_store_x4(rval, dst, index, negmask, absval, clz_x4_avx2<Type>(absval));
+        }
+    }
+
+    // handle any leftovers
+    fild_batch_scalar<Type>(cw, sw, dst, src, index, count);
+}
+
+//
+// AVX-512 version: identical, but uses the AVX-512CD vector lzcnt
+//
+template<typename Type, typename ArrayType>
+X87_TARGET_AVX512 static void fild_batch_avx512(x87cw_t cw, x87sw_t &sw, ArrayType dst, Type const *src, size_t count)
+{
+    x87cw_t rval = cw & X87CW_ROUNDING_MASK;
+    size_t index = 0;
+    for ( ; index + 4 <= count; index += 4)
+    {
+        if constexpr (std::is_same_v<ArrayType, fp64_t *> && sizeof(Type) != 8)
+            fild_fp64_small_x4(&dst[index], &src[index]);
+        else
+        {
+            __m256i raw = load_int_x4(&src[index]);
+            __m256i negmask = _mm256_cmpgt_epi64(_mm256_setzero_si256(), raw);
+            __m256i absval = _mm256_sub_epi64(_mm256_xor_si256(raw, negmask), negmask);
+            fild_store_x4(rval, dst, index, negmask, absval, _mm256_lzcnt_epi64(absval));
+        }
+    }
+
+    // handle any leftovers
+    fild_batch_scalar<Type>(cw, sw, dst, src, index, count);
+}
+
+#endif
+
+//
+// select the best version for the host
+//
+template<typename Type, typename ArrayType>
+static void fild_batch(x87cw_t cw, x87sw_t &sw, ArrayType dst, Type const *src, size_t count)
+{
+#if X87_SIMD_X64
+    if (host_has_avx512())
+        return fild_batch_avx512<Type>(cw, sw, dst, src, count);
+    if (host_has_avx2())
+        return fild_batch_avx2<Type>(cw, sw, dst, src, count);
+#endif
+    fild_batch_scalar<Type>(cw, sw, dst, src, 0, count);
+}
+
+//
+// entry points
+//
+template<typename Type>
+void fp80_t::x87_fild_batch(x87cw_t cw, x87sw_t &sw, fp80_t *dst, void const *src, size_t count)
+{
+    fild_batch<Type>(cw, sw, dst, static_cast<Type const *>(src), count);
+}
+template void fp80_t::x87_fild_batch<int64_t>(x87cw_t cw, x87sw_t &sw, fp80_t *dst, void const *src, size_t count);
+template void fp80_t::x87_fild_batch<int32_t>(x87cw_t cw, x87sw_t &sw, fp80_t *dst, void const *src, size_t count);
+template void fp80_t::x87_fild_batch<int16_t>(x87cw_t cw, x87sw_t &sw, fp80_t *dst, void const *src, size_t count);
+
+template<typename Type>
+void fp80_t::x87_fild_batch(x87cw_t cw, x87sw_t &sw, fp80_array_view_t const &dst, void const *src)
+{
+    fild_batch<Type>(cw, sw, dst, static_cast<Type const *>(src), dst.size());
+}
+template void fp80_t::x87_fild_batch<int64_t>(x87cw_t cw, x87sw_t &sw, fp80_array_view_t const &dst, void const *src);
+template void fp80_t::x87_fild_batch<int32_t>(x87cw_t cw, x87sw_t &sw, fp80_array_view_t const &dst, void const *src);
+template void fp80_t::x87_fild_batch<int16_t>(x87cw_t cw, x87sw_t &sw, fp80_array_view_t const &dst, void const *src);
+
+template<typename Type>
+void fp80_t::x87_fild_batch(x87cw_t cw, x87sw_t &sw, fp64_t *dst, void const *src, size_t count)
+{
+    fild_batch<Type>(cw, sw, dst, static_cast<Type const *>(src), count);
+}
+template void fp80_t::x87_fild_batch<int64_t>(x87cw_t cw, x87sw_t &sw, fp64_t *dst, void const *src, size_t count);
+template void fp80_t::x87_fild_batch<int32_t>(x87cw_t cw, x87sw_t &sw, fp64_t *dst, void const *src, size_t count);
+template void fp80_t::x87_fild_batch<int16_t>(x87cw_t cw, x87sw_t &sw, fp64_t *dst, void const *src, size_t count);
+
+
+
+//===========================================================================
+//
+// x87_fxam_batch
+//
+// Batch FXAM, writing the condition codes for each value.
+//
+//===========================================================================
+
+//
+// scalar version
+//
+template<typename ArrayType>
+static void fxam_batch_scalar(ArrayType src, uint16_t *dst, size_t index, size_t count)
+{
+    for ( ; index < count; index++)
+        dst[index] = fp80_t::x87_fxam(get_fp80(src, index));
+}
+
+#if X87_SIMD_X64
+
+//
+// AVX2 version: every lane is classified with compares and masks
+//
+template<typename ArrayType>
+X87_TARGET_AVX2 static void fxam_batch_avx2(ArrayType src, uint16_t *dst, size_t count)
+{
+    size_t index = 0;
+    for ( ; index + 4 <= count; index += 4)
+    {
+        __m256i mantissa, sign_exp;
+        load_fp80x4(src, index, mantissa, sign_exp);
+        store_narrow_x4(&dst[index], fxam_fp80_x4(mantissa, sign_exp));
+    }
+
+    // handle any leftovers
+    fxam_batch_scalar(src, dst, index, count);
+}
+
+#endif
+
+//
+// select the best version for the host
+//
+template<typename ArrayType>
+static void fxam_batch(ArrayType src, uint16_t *dst, size_t count)
+{
+#if X87_SIMD_X64
+    if (host_has_avx2())
+        return fxam_batch_avx2(src, dst, count);
+#endif
+    fxam_batch_scalar(src, dst, 0, count);
+}
+
+//
+// entry points
+//
+void fp80_t::x87_fxam_batch(fp80_t const *src, uint16_t *dst, size_t count)
+{
+    fxam_batch(src, dst, count);
+}
+
+void fp80_t::x87_fxam_batch(fp80_array_view_t const &src, uint16_t *dst)
+{
+    fxam_batch(src, dst, src.size());
+}
+
+
+
+//===========================================================================
+//
+// fp80_array_view_t::pack
+// fp80_array_view_t::unpack
+//
+// Conversion between split views and packed fp80_t arrays.
+//
+//===========================================================================
+
+//
+// scalar version
+//
+template<typename DstType, typename SrcType>
+static void copy_fp80_scalar(DstType dst, SrcType src, size_t index, size_t count)
+{
+    for ( ; index < count; index++)
+        set_fp80(dst, index, get_fp80(src, index));
+}
+
+#if X87_SIMD_X64
+
+//
+// AVX2 version
+//
+template<typename DstType, typename SrcType>
+X87_TARGET_AVX2 static void copy_fp80_avx2(DstType dst, SrcType src, size_t count)
+{
+    size_t index = 0;
+    for ( ; index + 4 <= count; index += 4)
+    {
+        __m256i mantissa, sign_exp;
+        load_fp80x4(src, index, mantissa, sign_exp);
+        store_fp80x4(dst, index, mantissa, sign_exp);
+    }
+
+    // handle any leftovers
+    copy_fp80_scalar(dst, src, index, count);
+}
+
+#endif
+
+//
+// entry points
+//
+void fp80_array_view_t::pack(fp80_t *dst) const
+{
+#if X87_SIMD_X64
+    if (host_has_avx2())
+        return copy_fp80_avx2(dst, *this, m_count);
+#endif
+    copy_fp80_scalar(dst, *this, 0, m_count);
+}
+
+void fp80_array_view_t::unpack(fp80_t const *src) const
+{
+#if X87_SIMD_X64
+    if (host_has_avx2())
+        return copy_fp80_avx2(*this, src, m_count);
+#endif
+    copy_fp80_scalar(*this, src, 0, m_count);
+}
+
+}
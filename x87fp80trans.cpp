@@ -172,50 +172,15 @@ static uint16_t x87_f2xm1_core(fp80_t const &src, fp80_t &dst)
         goto tiny;
 
     // parameters
-    static const int LOG_R = 4;
-    static const int R = 1 << LOG_R;
-    static const int TABLE_SIZE = 2 * R + 1;
-    static const int TAYLOR_TERMS = 9;
+    static constexpr int LOG_R = 4;
+    static constexpr int R = 1 << LOG_R;
+    static constexpr int TABLE_SIZE = 2 * R + 1;
+    static constexpr int TAYLOR_TERMS = 9;
 
 using fpext_t = fpext96_t;
 using fpextfast_t = fpext64_t;
-    static fpext_t const s_table_g[TABLE_SIZE] =
-    {
-        fpext_t(0x8000000000000000ull, 0x00000000, -1, 1),    // 2^(-16/16) = -0.5l,
-        fpext_t(0xf4aa7930676f09d6ull, 0x746d48e8, -2, 1),    // 2^(-15/16) = -0.47786310878629307983901676063004l,
-        fpext_t(0xe8d47c382ae85232ull, 0x08373af1, -2, 1),    // 2^(-14/16) = -0.45474613366737117039649467211965l,
-        fpext_t(0xdc785918a9dc7993ull, 0xe0524e3f, -2, 1),    // 2^(-13/16) = -0.43060568262165417314808485807924l,
-        fpext_t(0xcf901f5ce48ead21ull, 0x72a5b9d0, -2, 1),    // 2^(-12/16) = -0.40539644249863946664125001471976l,
-        fpext_t(0xc2159b3edcbddca4ull, 0xbeddc1ec, -2, 1),    // 2^(-11/16) = -0.3790710939632579757031612656367l,
-        fpext_t(0xb40252ac9d5d8e2bull, 0xc685013c, -2, 1),    // 2^(-10/16) = -0.35158022267449516703312294110377l,
-        fpext_t(0xa54f822b7abd6a73ull, 0x6cfeae6e, -2, 1),    // 2^( -9/16) = -0.32287222653155363585099262992965l,
-        fpext_t(0x95f619980c4336f7ull, 0x4d04ec99, -2, 1),    // 2^( -8/16) = -0.29289321881345247559915563789515l,
-        fpext_t(0x85eeb8c14fe79282ull, 0xaefdc093, -2, 1),    // 2^( -7/16) = -0.26158692703025034430654625981298l,
-        fpext_t(0xea6357baabe4948bull, 0x0754bcda, -3, 1),    // 2^( -6/16) = -0.22889458729602958819385406895463l,
-        fpext_t(0xc76dcfab81edfc70ull, 0x7729f1c2, -3, 1),    // 2^( -5/16) = -0.1947548340253728459102396663213l,
-        fpext_t(0xa2ec0cd4a58a542full, 0x1965d11a, -3, 1),    // 2^( -4/16) = -0.15910358474628545696887452376679l,
-        fpext_t(0xf999089eab58f777ull, 0xcd3b57dc, -4, 1),    // 2^( -3/16) = -0.12187391981335025844391969031234l,
-        fpext_t(0xa9f9c8c116de3689ull, 0x7e945264, -4, 1),    // 2^( -2/16) = -0.08299595679532876825645840520586l,
-        fpext_t(0xada82eadb7933d38ull, 0x462f3851, -5, 1),    // 2^( -1/16) = -0.04239671930142635306369436485208l,
-        fpext_t(0x0000000000000000ull, 0x00000000, fpext_t::EXPONENT_MIN, 0), // 0
-        fpext_t(0xb5586cf9890f6298ull, 0xb92b7184, -5, 0),    // 2^( +1/16) = 0.04427378242741384032196647873993l,
-        fpext_t(0xb95c1e3ea8bd6e6full, 0xbe462876, -4, 0),    // 2^( +2/16) = 0.09050773266525765920701065576071l,
-        fpext_t(0x8e1e9b9d588e19b0ull, 0x7eb6c705, -3, 0),    // 2^( +3/16) = 0.13878863475669165370383028384151l,
-        fpext_t(0xc1bf828c6dc54b7aull, 0x356918c1, -3, 0),    // 2^( +4/16) = 0.18920711500272106671749997056048l,
-        fpext_t(0xf7a993048d088d6dull, 0x0488f84f, -3, 0),    // 2^( +5/16) = 0.2418578120734840485936774687266l,
-        fpext_t(0x97fb5aa6c544e3a8ull, 0x72f5fd88, -2, 0),    // 2^( +6/16) = 0.29683955465100966593375411779245l,
-        fpext_t(0xb560fba90a852b19ull, 0x2602a324, -2, 0),    // 2^( +7/16) = 0.3542555469368927282980147401407l,
-        fpext_t(0xd413cccfe7799211ull, 0x65f626ce, -2, 0),    // 2^( +8/16) = 0.4142135623730950488016887242097l,
-        fpext_t(0xf4228e7d6030dafaull, 0xa2047eda, -2, 0),    // 2^( +9/16) = 0.47682614593949931138690748037405l,
-        fpext_t(0x8ace5422aa0db5baull, 0x7c55a193, -1, 0),    // 2^(+10/16) = 0.54221082540794082361229186209073l,
-        fpext_t(0x9c49182a3f0901c7ull, 0xc46b071f, -1, 0),    // 2^(+11/16) = 0.6104903319492543081795206673574l,
-        fpext_t(0xae89f995ad3ad5e8ull, 0x734d1773, -1, 0),    // 2^(+12/16) = 0.68179283050742908606225095246643l,
-        fpext_t(0xc199bdd85529c222ull, 0x0cb12a09, -1, 0),    // 2^(+13/16) = 0.75625216037329948311216061937531l,
-        fpext_t(0xd5818dcfba48725dull, 0xa05aeb67, -1, 0),    // 2^(+14/16) = 0.83400808640934246348708318958829l,
-        fpext_t(0xea4afa2a490d9858ull, 0xf73a18f6, -1, 0),    // 2^(+15/16) = 0.91520656139714729387261127029583l,
-        fpext_t(0x8000000000000000ull, 0x00000000,  0, 0)     // 2^(+16/16) = 1.0
-    };
-    static fpextfast_t const s_table_u[TABLE_SIZE] =
+    static constexpr fpext_table_t s_table_g = exp2m1_table<fpext_t, R>();    // 2^(k/R) - 1
+    static constexpr fpextfast_t s_table_u[TABLE_SIZE] =
     {
         fpextfast_t(0x8000000000000000ull, 0x00000000,  0, 1),    // -16/16
         fpextfast_t(0xf000000000000000ull, 0x00000000, -1, 1),    // -15/16
@@ -251,7 +216,7 @@ using fpextfast_t = fpext64_t;
         fpextfast_t(0xf000000000000000ull, 0x00000000, -1, 0),    //  15/16
         fpextfast_t(0x8000000000000000ull, 0x00000000,  0, 0)     //  16/16
     };
-    static fpextfast_t const s_taylor_coeff[8] =
+    static constexpr fpextfast_t s_taylor_coeff[8] =
     {
         fpextfast_t(0x9000000000000000ull, 0x00000000,  3, 0),    // 9
         fpextfast_t(0x9000000000000000ull, 0x00000000,  6, 0),    // 9*8
@@ -262,7 +227,7 @@ using fpextfast_t = fpext64_t;
         fpextfast_t(0xb130000000000000ull, 0x00000000, 17, 0),    // 9*8*7*6*5*4*3
         fpextfast_t(0xb130000000000000ull, 0x00000000, 18, 0)     // 9*8*7*6*5*4*3*2
     };
-    static fpextfast_t const s_taylor_factorial_inv =
+    static constexpr fpextfast_t s_taylor_factorial_inv =
         fpextfast_t(0xb8ef1d2ab6399c7dull, 0x560e4473, -19, 0);   // 1.0/9!
 
     {
@@ -325,14 +290,12 @@ using fpextfast_t = fpext64_t;
         // return g * h + g + h
         if (Debug)
         {
-            fpext_t res = g * h;
-            if (Debug) print_val("res", res);
-            res += g;
+            fpext_t res = fpext_t::fma(g, h, g);
             if (Debug) print_val("res", res);
             res += h;
             if (Debug) print_val("res", res);
         }
-        dst = (g * h + g + h).as_fp80();
+        dst = (fpext_t::fma(g, h, g) + h).as_fp80();
         return X87SW_PRECISION_EX;
     }
 
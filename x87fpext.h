@@ -43,6 +43,9 @@
 #include "x87fp64.h"
 #include "x87fp80.h"
 
+#include <array>
+#include <utility>
+
 
 namespace x87
 {
@@ -70,16 +73,17 @@ public:
     //
     // constructor for the common extended form
     //
-    explicit fpext52_t() { }
-    explicit fpext52_t(uint64_t high, uint32_t low, int32_t exponent, uint16_t sign);
+    constexpr explicit fpext52_t() { }
+    constexpr explicit fpext52_t(uint64_t high, uint32_t low, int32_t exponent, uint16_t sign) :
+        fp64_t(fp64_t::from_fpbits64(compose_bits(high, low, exponent, sign))) { }
 
     //
     // converting constructors
     //
     template<typename SrcExtendedType> explicit fpext52_t(fpextxx_t<SrcExtendedType> const &src);
-    explicit fpext52_t(fp64_t const &src) : fp64_t(src) { }
+    constexpr explicit fpext52_t(fp64_t const &src) : fp64_t(src) { }
     explicit fpext52_t(fp80_t const &src) : fp64_t(src) { }
-    explicit fpext52_t(double src) : fp64_t(src) { }
+    constexpr explicit fpext52_t(double src) : fp64_t(src) { }
 
     //
     // raw parts
@@ -100,7 +104,7 @@ public:
     // conversions
     //
     fp64_t as_fp64() const { return *this; }
-    double as_double() const { return m_value.d; }
+    constexpr double as_double() const { return m_value.d; }
     fp80_t as_fp80() const { return this->fp64_t::as_fp80(); }
 
     //
@@ -120,6 +124,7 @@ public:
     fpext52_t &operator+=(fpext52_t const &rhs) { static_cast<fp64_t &>(*this) += static_cast<fp64_t const &>(rhs); return *this; }
     fpext52_t &operator-=(fpext52_t const &rhs) { static_cast<fp64_t &>(*this) -= static_cast<fp64_t const &>(rhs); return *this; }
     fpext52_t &operator*=(fpext52_t const &rhs) { static_cast<fp64_t &>(*this) *= static_cast<fp64_t const &>(rhs); return *this; }
+    fpext52_t &operator/=(fpext52_t const &rhs) { static_cast<fp64_t &>(*this) /= static_cast<fp64_t const &>(rhs); return *this; }
 
     //
     // comparison operators
@@ -137,6 +142,7 @@ public:
     friend fpext52_t operator+(fpext52_t const &a, fpext52_t const &b) { return fpext52_t(static_cast<fp64_t const &>(a) + static_cast<fp64_t const &>(b)); }
     friend fpext52_t operator-(fpext52_t const &a, fpext52_t const &b) { return fpext52_t(static_cast<fp64_t const &>(a) - static_cast<fp64_t const &>(b)); }
     friend fpext52_t operator*(fpext52_t const &a, fpext52_t const &b) { return fpext52_t(static_cast<fp64_t const &>(a) * static_cast<fp64_t const &>(b)); }
+    friend fpext52_t operator/(fpext52_t const &a, fpext52_t const &b) { return fpext52_t(static_cast<fp64_t const &>(a) / static_cast<fp64_t const &>(b)); }
 
     //
     // core operations
@@ -149,6 +155,15 @@ public:
     static fpext52_t ldexp(fpext52_t const &a, int32_t dexp) { return fpext52_t(fp64_t::ldexp(a, dexp)); }
     static fpext52_t floor(fpext52_t const &a) { return fpext52_t(fp64_t::floor(a)); }
     static fpext52_t floor_abs_loint(fpext52_t const &a, uint64_t &intbits);
+    static fpext52_t recip(fpext52_t const &a) { return fpext52_t(1.0 / a.m_value.d); }
+    static fpext52_t rsqrt(fpext52_t const &a) { return fpext52_t(1.0 / std::sqrt(a.m_value.d)); }
+
+    //
+    // multiply-add step for polynomial evaluation; the multiply and add are
+    // deliberately left unfused so that results match the 4-lane versions,
+    // which relies on building without fp contraction (see x87common.h)
+    //
+    static fpext52_t fma(fpext52_t const &a, fpext52_t const &b, fpext52_t const &c) { return a * b + c; }
 
     //
     // constant values
@@ -164,6 +179,12 @@ public:
     static fpext52_t const pio4;
     static fpext52_t const lg2;
     static fpext52_t const ln2;
+
+private:
+    //
+    // internal helpers
+    //
+    static constexpr uint64_t compose_bits(uint64_t high, uint32_t low, int32_t exponent, uint16_t sign);
 };
 
 
@@ -185,24 +206,34 @@ public:
 //      ahead of time. Infinities can be produced when collapsing huge
 //      values to fp64_t or fp80_t.
 //
-//   * Full-precision divides are not supported.
+//   * Divides, reciprocals, and reciprocal square roots start from a
+//      double-precision estimate refined by Newton steps in the full
+//      precision, so they are accurate to a couple of ulps but are not
+//      correctly rounded. They cost roughly 4-6 multiplies.
 //
 // Multiple precisions are supported, based on the mantissa size:
 //
 //   fpext64_t: 64-bit mantissa; fastest by far, so use if possible
 //
+//   fpext80_t: 64-bit mantissa plus 16 bits of extension; the same 16
+//      bytes as fpext64_t, and the cross products in multiply fit in plain
+//      64-bit multiplies
+//
 //   fpext96_t: 64-bit mantissa plus 32 bits of extension; add/sub are
 //      a bit more expensive, multiply is a lot more expensive
 //
+//   fpext128_t: 64-bit mantissa plus 64 bits of extension; add/sub cost
+//      about the same as fpext96_t, multiply needs four 64x64 products
+//
 //===========================================================================
 
 template<typename ExtendedType>
 class fpextxx_t
 {
     //
-    // ExtendedType can be uint8_t (no extension), uint16_t or uint32_t
+    // ExtendedType can be uint8_t (no extension), uint16_t, uint32_t or uint64_t
     //
-    static_assert(sizeof(ExtendedType) <= 4);
+    static_assert(sizeof(ExtendedType) <= 8);
 
     //
     // bit of a kludge, but treat ExtendedType of less than 16 bits as none
@@ -229,7 +260,11 @@ public:
     //
     // default constructor
     //
-    explicit fpextxx_t()
+    constexpr explicit fpextxx_t() :
+        m_mantissa(0),
+        m_extend(0),
+        m_sign(0),
+        m_exponent(0)
     {
     }
 
@@ -238,91 +273,105 @@ public:
     //
     constexpr explicit fpextxx_t(mantissa_t high, uint32_t low, exponent_t exp, sign_t sign) :
         m_mantissa(high + (EXTENDED ? 0 : (low >> 31))),
-        m_extend((EXTEND_BITS == 32) ? low : (EXTEND_BITS == 16) ? ((low >> 16) + ((low >> 15) & 1)) : 0),
-        m_exponent(exp),
-        m_sign(sign)
+        m_extend(extend_t((EXTEND_BITS == 64) ? (uint64_t(low) << 32) : (EXTEND_BITS == 32) ? low : (EXTEND_BITS == 16) ? ((low >> 16) + ((low >> 15) & 1)) : 0)),
+        m_sign(sign),
+        m_exponent(exp)
     {
     }
 
     //
     // converting constructors
     //
-    template<typename SrcExtendedType> explicit fpextxx_t(fpextxx_t<SrcExtendedType> const &src, bool round = false);
-    explicit fpextxx_t(fp64_t const &src);
+    template<typename SrcExtendedType> constexpr explicit fpextxx_t(fpextxx_t<SrcExtendedType> const &src, bool round = false);
+    constexpr explicit fpextxx_t(fp64_t const &src);
     explicit fpextxx_t(fp80_t const &src);
-    explicit fpextxx_t(double src) : fpextxx_t(fp64_t(src)) { }
+    constexpr explicit fpextxx_t(double src) : fpextxx_t(fp64_t(src)) { }
 
     //
     // raw parts
     //
     constexpr bool extended() const { return EXTENDED; }
-    sign_t sign() const { return m_sign; }
-    exponent_t exponent() const { return m_exponent; }
-    mantissa_t mantissa() const { return m_mantissa; }
-    extend_t extend() const { return EXTENDED ? m_extend : 0; }
+    constexpr sign_t sign() const { return m_sign; }
+    constexpr exponent_t exponent() const { return m_exponent; }
+    constexpr mantissa_t mantissa() const { return m_mantissa; }
+    constexpr extend_t extend() const { return EXTENDED ? m_extend : 0; }
 
     //
     // raw setters
     //
-    void set_sign(sign_t sign) { m_sign = sign; }
-    void set_exponent(exponent_t exp) { m_exponent = exp; }
+    constexpr void set_sign(sign_t sign) { m_sign = sign; }
+    constexpr void set_exponent(exponent_t exp) { m_exponent = exp; }
 
     //
     // conversions
     //
-    fp64_t as_fp64() const;
-    double as_double() const { return this->as_fp64().as_double(); }
+    constexpr fp64_t as_fp64() const;
+    constexpr double as_double() const { return this->as_fp64().as_double(); }
     fp80_t as_fp80() const;
 
     //
     // queries
     //
-    bool iszero() const { return (m_mantissa == 0 && (!EXTENDED || m_extend == 0)); }
+    constexpr bool iszero() const { return (m_mantissa == 0 && (!EXTENDED || m_extend == 0)); }
 
     //
     // unary self operations
     //
-    fpextxx_t &abs() { m_sign = 0; return *this; }
-    fpextxx_t &chs() { m_sign ^= 1; return *this; }
+    constexpr fpextxx_t &abs() { m_sign = 0; return *this; }
+    constexpr fpextxx_t &chs() { m_sign ^= 1; return *this; }
 
     //
     // operators
     //
-    fpextxx_t &operator+=(fpextxx_t const &rhs) { this->add(*this, rhs); return *this; }
-    fpextxx_t &operator-=(fpextxx_t const &rhs) { this->sub(*this, rhs); return *this; }
-    fpextxx_t &operator*=(fpextxx_t const &rhs) { this->mul(*this, rhs); return *this; }
+    constexpr fpextxx_t &operator+=(fpextxx_t const &rhs) { this->add(*this, rhs); return *this; }
+    constexpr fpextxx_t &operator-=(fpextxx_t const &rhs) { this->sub(*this, rhs); return *this; }
+    constexpr fpextxx_t &operator*=(fpextxx_t const &rhs) { this->mul(*this, rhs); return *this; }
+    constexpr fpextxx_t &operator/=(fpextxx_t const &rhs) { this->div(*this, rhs); return *this; }
 
     //
     // comparison operators
     //
-    bool operator==(fpextxx_t const &rhs) const;
-    bool operator!=(fpextxx_t const &rhs) const;
-    bool operator>(fpextxx_t const &rhs) const;
-    bool operator>=(fpextxx_t const &rhs) const;
-    bool operator<(fpextxx_t const &rhs) const;
-    bool operator<=(fpextxx_t const &rhs) const;
+    constexpr bool operator==(fpextxx_t const &rhs) const;
+    constexpr bool operator!=(fpextxx_t const &rhs) const;
+    constexpr bool operator>(fpextxx_t const &rhs) const;
+    constexpr bool operator>=(fpextxx_t const &rhs) const;
+    constexpr bool operator<(fpextxx_t const &rhs) const;
+    constexpr bool operator<=(fpextxx_t const &rhs) const;
 
     //
     // friends
     //
-    friend fpextxx_t operator+(fpextxx_t const &a, fpextxx_t const &b) { fpextxx_t res; res.add(a, b); return res; }
-    friend fpextxx_t operator-(fpextxx_t const &a, fpextxx_t const &b) { fpextxx_t res; res.sub(a, b); return res; }
-    friend fpextxx_t operator*(fpextxx_t const &a, fpextxx_t const &b) { fpextxx_t res; res.mul(a, b); return res; }
+    friend constexpr fpextxx_t operator+(fpextxx_t const &a, fpextxx_t const &b) { fpextxx_t res; res.add(a, b); return res; }
+    friend constexpr fpextxx_t operator-(fpextxx_t const &a, fpextxx_t const &b) { fpextxx_t res; res.sub(a, b); return res; }
+    friend constexpr fpextxx_t operator*(fpextxx_t const &a, fpextxx_t const &b) { fpextxx_t res; res.mul(a, b); return res; }
+    friend constexpr fpextxx_t operator/(fpextxx_t const &a, fpextxx_t const &b) { fpextxx_t res; res.div(a, b); return res; }
+    template<typename, size_t> friend class fpext_table_t;
 
     //
     // core operations
     //
-    void add(fpextxx_t const &a, fpextxx_t const &b);
-    void sub(fpextxx_t const &a, fpextxx_t const &b);
-    void mul(fpextxx_t const &a, fpextxx_t const &b);
+    constexpr void add(fpextxx_t const &a, fpextxx_t const &b);
+    constexpr void sub(fpextxx_t const &a, fpextxx_t const &b);
+    constexpr void mul(fpextxx_t const &a, fpextxx_t const &b);
+    constexpr void div(fpextxx_t const &a, fpextxx_t const &b);
     fpextxx_t div64(fpextxx_t const &b) const { return fpextxx_t(this->as_fp64() / b.as_fp64()); }
 
     //
     // static helpers
     //
-    static fpextxx_t ldexp(fpextxx_t const &a, int32_t dexp) { fpextxx_t res = a; res.m_exponent += dexp; return res; }
-    static fpextxx_t floor(fpextxx_t const &a);
-    static fpextxx_t floor_abs_loint(fpextxx_t const &a, uint64_t &intbits);
+    static constexpr fpextxx_t ldexp(fpextxx_t const &a, int32_t dexp) { fpextxx_t res = a; res.m_exponent += dexp; return res; }
+    static constexpr fpextxx_t floor(fpextxx_t const &a);
+    static constexpr fpextxx_t floor_abs_loint(fpextxx_t const &a, uint64_t &intbits);
+    static constexpr fpextxx_t recip(fpextxx_t const &a);
+    static fpextxx_t rsqrt(fpextxx_t const &a);
+    static constexpr fpextxx_t from_string(char const *str);
+
+    //
+    // multiply-add step for polynomial evaluation, computing a * b + c with
+    // a single rounding; fpext128_t is the exception, and rounds the product
+    // and the sum separately like fpext52_t and fpext106_t
+    //
+    static constexpr fpextxx_t fma(fpextxx_t const &a, fpextxx_t const &b, fpextxx_t const &c);
 
     //
     // constant values
@@ -343,15 +392,18 @@ private:
     //
     // internal primitives
     //
-    bool mantissa_eq(fpextxx_t const &a) const;
-    bool mantissa_gt(fpextxx_t const &a) const;
-    bool mantissa_lt(fpextxx_t const &a) const;
-    void round_mantissa_up();
-    void round_extend_up();
-    void shift_mantissa_right(int count);
-    void normalize();
-    void add_values(fpextxx_t const &src1, fpextxx_t const &src2, int src2shift);
-    void sub_values(fpextxx_t const &src1, fpextxx_t const &src2, int src2shift);
+    constexpr bool mantissa_eq(fpextxx_t const &a) const;
+    constexpr bool mantissa_gt(fpextxx_t const &a) const;
+    constexpr bool mantissa_lt(fpextxx_t const &a) const;
+    constexpr void round_mantissa_up();
+    constexpr void round_extend_up();
+    constexpr void shift_mantissa_right(int count);
+    constexpr void normalize();
+    constexpr void shift_operand_right(int count, mantissa_t &mantissa, extend_t &extend) const;
+    constexpr void add_values(fpextxx_t const &src1, fpextxx_t const &src2, int src2shift);
+    constexpr void sub_values(fpextxx_t const &src1, fpextxx_t const &src2, int src2shift);
+    static constexpr void multiply_mantissas(fpextxx_t const &a, fpextxx_t const &b, uint64_t &lo, uint64_t &hi);
+    static constexpr fpextxx_t from_parts(mantissa_t mantissa, extend_t extend, exponent_t exp, sign_t sign);
 
     //
     // internal state
@@ -366,82 +418,305 @@ private:
 // derived types
 //
 using fpext64_t = fpextxx_t<uint8_t>;
+using fpext80_t = fpextxx_t<uint16_t>;
 using fpext96_t = fpextxx_t<uint32_t>;
+using fpext128_t = fpextxx_t<uint64_t>;
+
+//
+// the 16-bit extension packs alongside the sign, keeping fpext80_t the
+// same 16 bytes as fpext64_t
+//
+static_assert(sizeof(fpext80_t) == 16);
 
 
 
+//===========================================================================
 //
-// constants
+// fpext106_t
+//
+// Double-double form of a floating-point value: an unevaluated sum of two
+// doubles hi + lo, with |lo| no more than half an ulp of hi. This gives
+// 106 bits of mantissa using only native double operations, recovering
+// the rounding error of each product exactly with a fused multiply-add.
+// It implements the same interface as the fpextxx_t classes above, with
+// the following limitations:
+//
+//   * The exponent range is that of a double. Values small enough to
+//      land in the double denormal range lose their low part, and huge
+//      values overflow to infinity.
+//
+//   * NaNs/infinities are not supported: these should be filtered out
+//      ahead of time.
+//
+//   * Arithmetic is not constexpr, since std::fma is not; constants can
+//      still be built at compile time from raw parts.
+//
+// Like the fpextxx_t classes, conversions to fp64_t/fp80_t truncate. Since
+// hi is already hi + lo rounded to nearest, as_fp64 only has to step hi
+// one ulp toward zero when lo is nonzero and of the opposite sign.
+//
+// Products rely on std::fma, so this is only fast on hosts with hardware
+// FMA; elsewhere the library falls back to a software fma and fpext96_t
+// is a better choice.
+//
+//===========================================================================
+
+class fpext106_t
+{
+public:
+    //
+    // public constants
+    //
+    static constexpr int MANTISSA_BITS = 106;
+    static constexpr int32_t EXPONENT_MIN = 0 - FP64_EXPONENT_BIAS;
+    static constexpr uint64_t EXPLICIT_ONE = 0x8000000000000000ull;
+
+    //
+    // default constructor
+    //
+    constexpr explicit fpext106_t() :
+        m_hi(0),
+        m_lo(0)
+    {
+    }
+
+    //
+    // constexpr constructor from raw parts for constants
+    //
+    constexpr explicit fpext106_t(uint64_t high, uint32_t low, int32_t exponent, uint16_t sign) :
+        fpext106_t(from_mantissa(high, uint64_t(low) << 32, exponent, sign))
+    {
+    }
+
+    //
+    // constexpr constructor from an unevaluated sum of two doubles; the
+    // caller must ensure that lo is no more than half an ulp of hi
+    //
+    constexpr explicit fpext106_t(double hi, double lo) :
+        m_hi(hi),
+        m_lo(lo)
+    {
+    }
+
+    //
+    // converting constructors
+    //
+    template<typename SrcExtendedType> explicit fpext106_t(fpextxx_t<SrcExtendedType> const &src);
+    constexpr explicit fpext106_t(fp64_t const &src) : fpext106_t(src.as_double(), 0.0) { }
+    explicit fpext106_t(fp80_t const &src);
+    constexpr explicit fpext106_t(double src) : fpext106_t(src, 0.0) { }
+
+    //
+    // raw parts
+    //
+    constexpr bool extended() const { return true; }
+    uint16_t sign() const { return std::signbit(m_hi) ? 1 : 0; }
+    int32_t exponent() const { return this->explode().exponent; }
+    uint64_t mantissa() const { return this->explode().mantissa; }
+    uint32_t extend() const { return uint32_t(this->explode().extend >> 32); }
+
+    //
+    // raw setters
+    //
+    void set_sign(uint16_t sign) { if (sign != this->sign()) this->chs(); }
+    void set_exponent(int32_t exp) { *this = ldexp(*this, exp - this->exponent()); }
+
+    //
+    // conversions
+    //
+    constexpr fp64_t as_fp64() const { return fp64_t(this->as_double()); }
+    constexpr double as_double() const { return std::bit_cast<double>(std::bit_cast<uint64_t>(m_hi) - uint64_t(m_lo != 0 && (m_lo < 0) != (m_hi < 0))); }
+    fp80_t as_fp80() const;
+    constexpr double hi() const { return m_hi; }
+    constexpr double lo() const { return m_lo; }
+
+    //
+    // queries
+    //
+    constexpr bool iszero() const { return (m_hi == 0); }
+
+    //
+    // unary self operations
+    //
+    fpext106_t &abs() { if (std::signbit(m_hi)) this->chs(); return *this; }
+    constexpr fpext106_t &chs() { m_hi = -m_hi; m_lo = -m_lo; return *this; }
+
+    //
+    // operators
+    //
+    fpext106_t &operator+=(fpext106_t const &rhs) { this->add(*this, rhs); return *this; }
+    fpext106_t &operator-=(fpext106_t const &rhs) { this->sub(*this, rhs); return *this; }
+    fpext106_t &operator*=(fpext106_t const &rhs) { this->mul(*this, rhs); return *this; }
+    fpext106_t &operator/=(fpext106_t const &rhs) { this->div(*this, rhs); return *this; }
+
+    //
+    // comparison operators
+    //
+    constexpr bool operator==(fpext106_t const &rhs) const { return (m_hi == rhs.m_hi && m_lo == rhs.m_lo); }
+    constexpr bool operator!=(fpext106_t const &rhs) const { return !(*this == rhs); }
+    constexpr bool operator>(fpext106_t const &rhs) const { return (m_hi > rhs.m_hi || (m_hi == rhs.m_hi && m_lo > rhs.m_lo)); }
+    constexpr bool operator>=(fpext106_t const &rhs) const { return !(*this < rhs); }
+    constexpr bool operator<(fpext106_t const &rhs) const { return (m_hi < rhs.m_hi || (m_hi == rhs.m_hi && m_lo < rhs.m_lo)); }
+    constexpr bool operator<=(fpext106_t const &rhs) const { return !(*this > rhs); }
+
+    //
+    // friends
+    //
+    friend fpext106_t operator+(fpext106_t const &a, fpext106_t const &b) { fpext106_t res; res.add(a, b); return res; }
+    friend fpext106_t operator-(fpext106_t const &a, fpext106_t const &b) { fpext106_t res; res.sub(a, b); return res; }
+    friend fpext106_t operator*(fpext106_t const &a, fpext106_t const &b) { fpext106_t res; res.mul(a, b); return res; }
+    friend fpext106_t operator/(fpext106_t const &a, fpext106_t const &b) { fpext106_t res; res.div(a, b); return res; }
+
+    //
+    // core operations
+    //
+    void add(fpext106_t const &a, fpext106_t const &b);
+    void sub(fpext106_t const &a, fpext106_t const &b);
+    void mul(fpext106_t const &a, fpext106_t const &b);
+    void div(fpext106_t const &a, fpext106_t const &b);
+    fpext106_t div64(fpext106_t const &b) const { return fpext106_t(this->as_fp64() / b.as_fp64()); }
+
+    //
+    // static helpers
+    //
+    static fpext106_t ldexp(fpext106_t const &a, int32_t dexp) { return fpext106_t(std::ldexp(a.m_hi, dexp), std::ldexp(a.m_lo, dexp)); }
+    static fpext106_t floor(fpext106_t const &a);
+    static fpext106_t floor_abs_loint(fpext106_t const &a, uint64_t &intbits);
+    static fpext106_t recip(fpext106_t const &a) { fpext106_t res; res.div(one, a); return res; }
+    static fpext106_t rsqrt(fpext106_t const &a);
+
+    //
+    // multiply-add step for polynomial evaluation, computing a * b + c; unlike
+    // fpextxx_t::fma this is not fused, and rounds the product and the sum
+    // to 106 bits separately
+    //
+    static fpext106_t fma(fpext106_t const &a, fpext106_t const &b, fpext106_t const &c) { fpext106_t res; res.mul(a, b); res.add(res, c); return res; }
+
+    //
+    // error-free transformations of double operations; quick_two_sum
+    // requires |a| >= |b|
+    //
+    static fpext106_t quick_two_sum(double a, double b) { double s = a + b; return fpext106_t(s, b - (s - a)); }
+    static fpext106_t two_sum(double a, double b) { double s = a + b; double bb = s - a; return fpext106_t(s, (a - (s - bb)) + (b - bb)); }
+    static fpext106_t two_prod(double a, double b) { double p = a * b; return fpext106_t(p, std::fma(a, b, -p)); }
+
+    //
+    // constant values
+    //
+    static fpext106_t const zero;
+    static fpext106_t const nzero;
+    static fpext106_t const one;
+    static fpext106_t const none;
+    static fpext106_t const l2t;
+    static fpext106_t const l2e;
+    static fpext106_t const pi;
+    static fpext106_t const pio2;
+    static fpext106_t const pio4;
+    static fpext106_t const lg2;
+    static fpext106_t const ln2;
+
+private:
+    //
+    // exploded form of the value, with a 1.127 mantissa
+    //
+    struct exploded_t
+    {
+        uint64_t mantissa;
+        uint64_t extend;
+        int32_t exponent;
+    };
+
+    //
+    // internal helpers
+    //
+    exploded_t explode() const;
+    static constexpr fpext106_t from_mantissa(uint64_t high, uint64_t low, int32_t exponent, uint16_t sign);
+    static constexpr double scale(double value, int32_t exponent);
+    static constexpr fpext106_t from_bits(uint64_t hi, uint64_t lo) { return fpext106_t(std::bit_cast<double>(hi), std::bit_cast<double>(lo)); }
+
+    //
+    // internal state
+    //
+    double m_hi;
+    double m_lo;
+};
+
+
+
 //
-fpext52_t const fpext52_t::zero (0x0000000000000000ull, 0x00000000, fpext52_t::EXPONENT_MIN, 0);
-fpext52_t const fpext52_t::nzero(0x0000000000000000ull, 0x00000000, fpext52_t::EXPONENT_MIN, 1);
-fpext52_t const fpext52_t::one  (0x8000000000000000ull, 0x00000000,  0, 0);
-fpext52_t const fpext52_t::none (0x8000000000000000ull, 0x00000000,  0, 1);
-fpext52_t const fpext52_t::l2t  (0xd49a784bcd1b8afeull, 0x492bf6ff,  1, 0);
-fpext52_t const fpext52_t::l2e  (0xb8aa3b295c17f0bbull, 0xbe87fed0,  0, 0);
-fpext52_t const fpext52_t::pi   (0xc90fdaa22168c234ull, 0xc4c6628c,  1, 0);
-fpext52_t const fpext52_t::pio2 (0xc90fdaa22168c234ull, 0xc4c6628c,  0, 0);
-fpext52_t const fpext52_t::pio4 (0xc90fdaa22168c234ull, 0xc4c6628c, -1, 0);
-fpext52_t const fpext52_t::lg2  (0x9a209a84fbcff798ull, 0x8f8959ac, -2, 0);
-fpext52_t const fpext52_t::ln2  (0xb17217f7d1cf79abull, 0xc9e3b398, -1, 0);
-
-template<> fpext64_t const fpext64_t::zero (0x0000000000000000ull, 0x00000000, fpext64_t::EXPONENT_MIN, 0);
-template<> fpext64_t const fpext64_t::nzero(0x0000000000000000ull, 0x00000000, fpext64_t::EXPONENT_MIN, 1);
-template<> fpext64_t const fpext64_t::one  (0x8000000000000000ull, 0x00000000,  0, 0);
-template<> fpext64_t const fpext64_t::none (0x8000000000000000ull, 0x00000000,  0, 1);
-template<> fpext64_t const fpext64_t::l2t  (0xd49a784bcd1b8afeull, 0x492bf6ff,  1, 0);
-template<> fpext64_t const fpext64_t::l2e  (0xb8aa3b295c17f0bbull, 0xbe87fed0,  0, 0);
-template<> fpext64_t const fpext64_t::pi   (0xc90fdaa22168c234ull, 0xc4c6628c,  1, 0);
-template<> fpext64_t const fpext64_t::pio2 (0xc90fdaa22168c234ull, 0xc4c6628c,  0, 0);
-template<> fpext64_t const fpext64_t::pio4 (0xc90fdaa22168c234ull, 0xc4c6628c, -1, 0);
-template<> fpext64_t const fpext64_t::lg2  (0x9a209a84fbcff798ull, 0x8f8959ac, -2, 0);
-template<> fpext64_t const fpext64_t::ln2  (0xb17217f7d1cf79abull, 0xc9e3b398, -1, 0);
-
-template<> fpext96_t const fpext96_t::zero (0x0000000000000000ull, 0x00000000, fpext96_t::EXPONENT_MIN, 0);
-template<> fpext96_t const fpext96_t::nzero(0x0000000000000000ull, 0x00000000, fpext96_t::EXPONENT_MIN, 1);
-template<> fpext96_t const fpext96_t::one  (0x8000000000000000ull, 0x00000000,  0, 0);
-template<> fpext96_t const fpext96_t::none (0x8000000000000000ull, 0x00000000,  0, 1);
-template<> fpext96_t const fpext96_t::l2t  (0xd49a784bcd1b8afeull, 0x492bf6ff,  1, 0);
-template<> fpext96_t const fpext96_t::l2e  (0xb8aa3b295c17f0bbull, 0xbe87fed0,  0, 0);
-template<> fpext96_t const fpext96_t::pi   (0xc90fdaa22168c234ull, 0xc4c6628c,  1, 0);
-template<> fpext96_t const fpext96_t::pio2 (0xc90fdaa22168c234ull, 0xc4c6628c,  0, 0);
-template<> fpext96_t const fpext96_t::pio4 (0xc90fdaa22168c234ull, 0xc4c6628c, -1, 0);
-template<> fpext96_t const fpext96_t::lg2  (0x9a209a84fbcff798ull, 0x8f8959ac, -2, 0);
-template<> fpext96_t const fpext96_t::ln2  (0xb17217f7d1cf79abull, 0xc9e3b398, -1, 0);
-
-
-
-//
-// construct an fpex52_t from high-precision components
-//
-fpext52_t::fpext52_t(uint64_t high, uint32_t low, int32_t exponent, uint16_t sign)
+// compute the raw fp64 bits of an fpext52_t from high-precision components
+//
+inline constexpr uint64_t fpext52_t::compose_bits(uint64_t high, uint32_t low, int32_t exponent, uint16_t sign)
 {
     int32_t exp = exponent + FP64_EXPONENT_BIAS;
 
     // compute a signed zero as the default case
-    m_value.i = uint64_t(sign) << FP64_SIGN_SHIFT;
+    uint64_t result = uint64_t(sign) << FP64_SIGN_SHIFT;
 
     // too big to fit? return signed infinity
     if (exp >= FP64_EXPONENT_MAX_BIASED)
-        m_value.i |= FP64_EXPONENT_MASK;
+        result |= FP64_EXPONENT_MASK;
 
     // normal case
     else if (exp > 0)
     {
-        m_value.i |= (uint64_t(exp) << FP64_EXPONENT_SHIFT) | ((high >> (63 - FP64_EXPONENT_SHIFT)) & FP64_MANTISSA_MASK);
-        m_value.i += (high >> (62 - FP64_EXPONENT_SHIFT)) & 1;
+        result |= (uint64_t(exp) << FP64_EXPONENT_SHIFT) | ((high >> (63 - FP64_EXPONENT_SHIFT)) & FP64_MANTISSA_MASK);
+        result += (high >> (62 - FP64_EXPONENT_SHIFT)) & 1;
     }
 
     // denormal case
     else if (exp > -52)
     {
-        m_value.i |= high >> (64 - FP64_EXPONENT_SHIFT - exp);
-        m_value.i += (63 - FP64_EXPONENT_SHIFT - exp);
+        result |= high >> (64 - FP64_EXPONENT_SHIFT - exp);
+        result += (63 - FP64_EXPONENT_SHIFT - exp);
     }
+    return result;
 }
 
 
 
+//
+// constants
+//
+inline constexpr fpext52_t fpext52_t::zero (0x0000000000000000ull, 0x00000000, fpext52_t::EXPONENT_MIN, 0);
+inline constexpr fpext52_t fpext52_t::nzero(0x0000000000000000ull, 0x00000000, fpext52_t::EXPONENT_MIN, 1);
+inline constexpr fpext52_t fpext52_t::one  (0x8000000000000000ull, 0x00000000,  0, 0);
+inline constexpr fpext52_t fpext52_t::none (0x8000000000000000ull, 0x00000000,  0, 1);
+inline constexpr fpext52_t fpext52_t::l2t  (0xd49a784bcd1b8afeull, 0x492bf6ff,  1, 0);
+inline constexpr fpext52_t fpext52_t::l2e  (0xb8aa3b295c17f0bbull, 0xbe87fed0,  0, 0);
+inline constexpr fpext52_t fpext52_t::pi   (0xc90fdaa22168c234ull, 0xc4c6628c,  1, 0);
+inline constexpr fpext52_t fpext52_t::pio2 (0xc90fdaa22168c234ull, 0xc4c6628c,  0, 0);
+inline constexpr fpext52_t fpext52_t::pio4 (0xc90fdaa22168c234ull, 0xc4c6628c, -1, 0);
+inline constexpr fpext52_t fpext52_t::lg2  (0x9a209a84fbcff798ull, 0x8f8959ac, -2, 0);
+inline constexpr fpext52_t fpext52_t::ln2  (0xb17217f7d1cf79abull, 0xc9e3b398, -1, 0);
+
+template<typename ExtendedType> inline constexpr fpextxx_t<ExtendedType> fpextxx_t<ExtendedType>::zero (0x0000000000000000ull, 0x00000000, fpextxx_t<ExtendedType>::EXPONENT_MIN, 0);
+template<typename ExtendedType> inline constexpr fpextxx_t<ExtendedType> fpextxx_t<ExtendedType>::nzero(0x0000000000000000ull, 0x00000000, fpextxx_t<ExtendedType>::EXPONENT_MIN, 1);
+template<typename ExtendedType> inline constexpr fpextxx_t<ExtendedType> fpextxx_t<ExtendedType>::one  (0x8000000000000000ull, 0x00000000,  0, 0);
+template<typename ExtendedType> inline constexpr fpextxx_t<ExtendedType> fpextxx_t<ExtendedType>::none (0x8000000000000000ull, 0x00000000,  0, 1);
+template<typename ExtendedType> inline constexpr fpextxx_t<ExtendedType> fpextxx_t<ExtendedType>::l2t  (0xd49a784bcd1b8afeull, 0x492bf6ff,  1, 0);
+template<typename ExtendedType> inline constexpr fpextxx_t<ExtendedType> fpextxx_t<ExtendedType>::l2e  (0xb8aa3b295c17f0bbull, 0xbe87fed0,  0, 0);
+template<typename ExtendedType> inline constexpr fpextxx_t<ExtendedType> fpextxx_t<ExtendedType>::pi   (0xc90fdaa22168c234ull, 0xc4c6628c,  1, 0);
+template<typename ExtendedType> inline constexpr fpextxx_t<ExtendedType> fpextxx_t<ExtendedType>::pio2 (0xc90fdaa22168c234ull, 0xc4c6628c,  0, 0);
+template<typename ExtendedType> inline constexpr fpextxx_t<ExtendedType> fpextxx_t<ExtendedType>::pio4 (0xc90fdaa22168c234ull, 0xc4c6628c, -1, 0);
+template<typename ExtendedType> inline constexpr fpextxx_t<ExtendedType> fpextxx_t<ExtendedType>::lg2  (0x9a209a84fbcff798ull, 0x8f8959ac, -2, 0);
+template<typename ExtendedType> inline constexpr fpextxx_t<ExtendedType> fpextxx_t<ExtendedType>::ln2  (0xb17217f7d1cf79abull, 0xc9e3b398, -1, 0);
+
+inline constexpr fpext106_t fpext106_t::zero (0.0, 0.0);
+inline constexpr fpext106_t fpext106_t::nzero(-0.0, -0.0);
+inline constexpr fpext106_t fpext106_t::one  (1.0, 0.0);
+inline constexpr fpext106_t fpext106_t::none (-1.0, -0.0);
+inline constexpr fpext106_t fpext106_t::l2t  = fpext106_t::from_bits(0x400a934f0979a371ull, 0x3ca7f2495fb7fa6dull);
+inline constexpr fpext106_t fpext106_t::l2e  = fpext106_t::from_bits(0x3ff71547652b82feull, 0x3c7777d0ffda0d24ull);
+inline constexpr fpext106_t fpext106_t::pi   = fpext106_t::from_bits(0x400921fb54442d18ull, 0x3ca1a62633145c07ull);
+inline constexpr fpext106_t fpext106_t::pio2 = fpext106_t::from_bits(0x3ff921fb54442d18ull, 0x3c91a62633145c07ull);
+inline constexpr fpext106_t fpext106_t::pio4 = fpext106_t::from_bits(0x3fe921fb54442d18ull, 0x3c81a62633145c07ull);
+inline constexpr fpext106_t fpext106_t::lg2  = fpext106_t::from_bits(0x3fd34413509f79ffull, 0xbc49dc1da994fd21ull);
+inline constexpr fpext106_t fpext106_t::ln2  = fpext106_t::from_bits(0x3fe62e42fefa39efull, 0x3c7abc9e3b39803full);
+
+
+
+
 //
 // construct an fpext52_t from a higher precision type
 //
@@ -458,10 +733,10 @@ fpext52_t::fpext52_t(fpextxx_t<SrcExtendedType> const &src) :
 //
 template<typename ExtendedType>
 template<typename SrcExtendedType>
-inline fpextxx_t<ExtendedType>::fpextxx_t(fpextxx_t<SrcExtendedType> const &src, bool round) :
+inline constexpr fpextxx_t<ExtendedType>::fpextxx_t(fpextxx_t<SrcExtendedType> const &src, bool round) :
     m_mantissa(src.mantissa()),
-    m_exponent(src.exponent()),
-    m_sign(src.sign())
+    m_sign(src.sign()),
+    m_exponent(src.exponent())
 {
     constexpr bool SRC_EXTENDED = (sizeof(SrcExtendedType) >= 2);
     constexpr int SRC_EXTEND_BITS = 8 * sizeof(SrcExtendedType);
@@ -473,7 +748,7 @@ inline fpextxx_t<ExtendedType>::fpextxx_t(fpextxx_t<SrcExtendedType> const &src,
 
         // if the source was extended, optionally round based on top extension bit
         if (SRC_EXTENDED && round)
-            if ((src.extend() & (1 << (SRC_EXTEND_BITS - 1))) != 0)
+            if ((src.extend() & (SrcExtendedType(1) << (SRC_EXTEND_BITS - 1))) != 0)
                 this->round_mantissa_up();
     }
 
@@ -482,10 +757,10 @@ inline fpextxx_t<ExtendedType>::fpextxx_t(fpextxx_t<SrcExtendedType> const &src,
     {
         constexpr int SRCSHIFT = (SRC_EXTEND_BITS - EXTEND_BITS) % SRC_EXTEND_BITS;
         constexpr int SRCSHIFTM1 = (SRCSHIFT + SRC_EXTEND_BITS - 1) % SRC_EXTEND_BITS;
-        m_extend = src.extend() >> SRCSHIFT;
+        m_extend = extend_t(src.extend() >> SRCSHIFT);
 
         // if rounding, check the bit we shifted out
-        if (round && (src.extend() & (1 << SRCSHIFTM1)) != 0)
+        if (round && (src.extend() & (SrcExtendedType(1) << SRCSHIFTM1)) != 0)
             this->round_extend_up();
     }
 
@@ -493,7 +768,7 @@ inline fpextxx_t<ExtendedType>::fpextxx_t(fpextxx_t<SrcExtendedType> const &src,
     else
     {
         constexpr int SRCSHIFT = (EXTEND_BITS - SRC_EXTEND_BITS) % EXTEND_BITS;
-        m_extend = src.extend() << SRCSHIFT;
+        m_extend = extend_t(src.extend()) << SRCSHIFT;
     }
 }
 
@@ -503,13 +778,13 @@ inline fpextxx_t<ExtendedType>::fpextxx_t(fpextxx_t<SrcExtendedType> const &src,
 // construct from an fp64 type
 //
 template<typename ExtendedType>
-inline fpextxx_t<ExtendedType>::fpextxx_t(fp64_t const &src) :
-    m_mantissa(src.mantissa() << (63 - FP64_EXPONENT_SHIFT)),
+inline constexpr fpextxx_t<ExtendedType>::fpextxx_t(fp64_t const &src) :
+    m_mantissa((src.as_fpbits64() & FP64_MANTISSA_MASK) << (63 - FP64_EXPONENT_SHIFT)),
     m_extend(0),
-    m_exponent(src.exponent()),
-    m_sign(src.sign())
+    m_sign(sign_t(src.as_fpbits64() >> FP64_SIGN_SHIFT)),
+    m_exponent(int32_t((src.as_fpbits64() & FP64_EXPONENT_MASK) >> FP64_EXPONENT_SHIFT) - FP64_EXPONENT_BIAS)
 {
-    x87_assert(!src.ismaxexp());
+    x87_assert((src.as_fpbits64() & FP64_EXPONENT_MASK) != FP64_EXPONENT_MASK);
 
     // insert the explicit one for normal numbers
     if (m_exponent != 0x000 - FP64_EXPONENT_BIAS)
@@ -532,8 +807,8 @@ template<typename ExtendedType>
 inline fpextxx_t<ExtendedType>::fpextxx_t(fp80_t const &src) :
     m_mantissa(src.mantissa()),
     m_extend(0),
-    m_exponent(src.exponent()),
-    m_sign(src.sign())
+    m_sign(src.sign()),
+    m_exponent(src.exponent())
 {
     x87_assert(!src.ismaxexp());
 
@@ -552,7 +827,7 @@ inline fpextxx_t<ExtendedType>::fpextxx_t(fp80_t const &src) :
 // convert to an fp64
 //
 template<typename ExtendedType>
-inline fp64_t fpextxx_t<ExtendedType>::as_fp64() const
+inline constexpr fp64_t fpextxx_t<ExtendedType>::as_fp64() const
 {
     uint64_t result = uint64_t(m_sign) << FP64_SIGN_SHIFT;
     exponent_t exp = m_exponent + FP64_EXPONENT_BIAS;
@@ -602,23 +877,39 @@ inline fp80_t fpextxx_t<ExtendedType>::as_fp80() const
 
 
 
+//
+// assemble a value from its raw parts, with the extension at full width
+//
+template<typename ExtendedType>
+inline constexpr fpextxx_t<ExtendedType> fpextxx_t<ExtendedType>::from_parts(mantissa_t mantissa, extend_t extend, exponent_t exp, sign_t sign)
+{
+    fpextxx_t result;
+    result.m_mantissa = mantissa;
+    result.m_extend = extend;
+    result.m_exponent = exp;
+    result.m_sign = sign;
+    return result;
+}
+
+
+
 //
 // compare two mantissas in various ways
 //
 template<typename ExtendedType>
-inline bool fpextxx_t<ExtendedType>::mantissa_eq(fpextxx_t const &a) const
+inline constexpr bool fpextxx_t<ExtendedType>::mantissa_eq(fpextxx_t const &a) const
 {
     return (m_mantissa == a.m_mantissa && (!EXTENDED || m_extend == a.m_extend));
 }
 
 template<typename ExtendedType>
-inline bool fpextxx_t<ExtendedType>::mantissa_gt(fpextxx_t const &a) const
+inline constexpr bool fpextxx_t<ExtendedType>::mantissa_gt(fpextxx_t const &a) const
 {
     return (m_mantissa > a.m_mantissa || (EXTENDED && m_mantissa == a.m_mantissa && m_extend > a.m_extend));
 }
 
 template<typename ExtendedType>
-inline bool fpextxx_t<ExtendedType>::mantissa_lt(fpextxx_t const &a) const
+inline constexpr bool fpextxx_t<ExtendedType>::mantissa_lt(fpextxx_t const &a) const
 {
     return (m_mantissa < a.m_mantissa || (EXTENDED && m_mantissa == a.m_mantissa && m_extend < a.m_extend));
 }
@@ -629,7 +920,7 @@ inline bool fpextxx_t<ExtendedType>::mantissa_lt(fpextxx_t const &a) const
 // round the mantissa up, overflowing into the exponent
 //
 template<typename ExtendedType>
-inline void fpextxx_t<ExtendedType>::round_mantissa_up()
+inline constexpr void fpextxx_t<ExtendedType>::round_mantissa_up()
 {
     if (++m_mantissa == 0)
     {
@@ -644,7 +935,7 @@ inline void fpextxx_t<ExtendedType>::round_mantissa_up()
 // round the extension bits up, overflowing into the mantissa
 //
 template<typename ExtendedType>
-inline void fpextxx_t<ExtendedType>::round_extend_up()
+inline constexpr void fpextxx_t<ExtendedType>::round_extend_up()
 {
     if (++m_extend == 0 && ++m_mantissa == 0)
     {
@@ -659,7 +950,7 @@ inline void fpextxx_t<ExtendedType>::round_extend_up()
 // shift the mantissa 'count' bits to the right
 //
 template<typename ExtendedType>
-inline void fpextxx_t<ExtendedType>::shift_mantissa_right(int count)
+inline constexpr void fpextxx_t<ExtendedType>::shift_mantissa_right(int count)
 {
     if (count < EXTEND_BITS)
     {
@@ -677,7 +968,7 @@ inline void fpextxx_t<ExtendedType>::shift_mantissa_right(int count)
 }
 
 template<>
-inline void fpextxx_t<uint8_t>::shift_mantissa_right(int count)
+inline constexpr void fpextxx_t<uint8_t>::shift_mantissa_right(int count)
 {
     m_mantissa >>= count;
 }
@@ -685,57 +976,64 @@ inline void fpextxx_t<uint8_t>::shift_mantissa_right(int count)
 
 
 //
-// normalize a denormalized or zero value
+// normalize a denormalized or zero value; the mantissa and extension are
+// treated as one funnel-shifted value so that no shift range needs its
+// own branch
 //
 template<typename ExtendedType>
-inline void fpextxx_t<ExtendedType>::normalize()
+inline constexpr void fpextxx_t<ExtendedType>::normalize()
 {
-    // if mantissa is all zeros, set exponent to minimum
-    if (this->iszero())
-        m_exponent = EXPONENT_MIN;
+    // if the mantissa is empty, start from the extension bits instead
+    uint64_t extend = EXTENDED ? (uint64_t(m_extend) << (64 - EXTEND_BITS)) : 0;
+    bool hizero = (EXTENDED && m_mantissa == 0);
+    uint64_t mantissa = select64(hizero, extend, m_mantissa);
+    extend = select64(hizero, 0, extend);
+    exponent_t exponent = m_exponent - 64 * hizero;
 
-    // if we have bits in the mantissa, shift them high
-    else if (!EXTENDED || m_mantissa != 0)
-    {
-        // determine shift amount
-        int shift = count_leading_zeros64(m_mantissa);
-        if (shift == 0)
-            return;
+    // shift the bits high; the double shift keeps a count of 0 defined
+    int shift = count_leading_zeros64(mantissa | 1);
+    m_mantissa = (mantissa << shift) | ((extend >> 1) >> (63 - shift));
+    m_extend = extend_t(EXTENDED ? ((extend << shift) >> (64 - EXTEND_BITS)) : 0);
 
-        // shift it up
-        m_mantissa <<= shift;
-        m_exponent -= shift;
+    // if there were no bits at all, set exponent to minimum
+    m_exponent = exponent_t(select64(m_mantissa == 0, uint64_t(EXPONENT_MIN), exponent - shift));
 
-        // shift in extended bits if we have some
-        if (EXTENDED)
-        {
-            if (shift < EXTEND_BITS)
-            {
-                m_mantissa |= m_extend >> (EXTEND_BITS - shift);
-                m_extend <<= shift;
-            }
-            else
-            {
-                m_mantissa |= mantissa_t(m_extend) << (shift - EXTEND_BITS);
-                m_extend = 0;
-            }
-        }
-    }
+    // verify
+    x87_assert(this->iszero() || (m_mantissa & EXPLICIT_ONE) != 0);
+}
 
-    // if we only have bits in the extension, move them high
-    else if (EXTENDED)
-    {
-        // determine shift amount
-        int shift = count_leading_zeros64(m_extend);
 
-        // shift it up
-        m_mantissa = mantissa_t(m_extend) << shift;
-        m_extend = 0;
-        m_exponent -= 64 + shift - (64 - EXTEND_BITS);
-    }
 
-    // verify
-    x87_assert(this->iszero() || (m_mantissa & EXPLICIT_ONE) != 0);
+//
+// shift an operand right by 'count' bits, which must be less than
+// MANTISSA_BITS, rounding by the last bit shifted out; the mantissa and
+// extension are treated as one 128-bit value so that the shift ranges
+// only need selects
+//
+template<typename ExtendedType>
+inline constexpr void fpextxx_t<ExtendedType>::shift_operand_right(int count, mantissa_t &mantissa, extend_t &extend) const
+{
+    // form the 128-bit value, with the extension at the top of the low word
+    uint64_t hi = m_mantissa;
+    uint64_t lo = uint64_t(m_extend) << (64 - EXTEND_BITS);
+
+    // funnel shift right; the double shift keeps a count of 0 defined
+    int subcount = count & 63;
+    bool big = (count >= 64);
+    uint64_t newlo = select64(big, hi >> subcount, (lo >> subcount) | ((hi << 1) << (63 - subcount)));
+    uint64_t newhi = select64(big, 0, hi >> subcount);
+
+    // find the last bit shifted out; a shift of exactly EXTEND_BITS has never
+    // rounded, so keep it that way
+    int roundpos = count + 63 - EXTEND_BITS;
+    uint64_t round = (select64(roundpos >= 64, hi, lo) >> (roundpos & 63)) & 1;
+    round &= uint64_t(count != 0 && count != EXTEND_BITS);
+
+    // apply the rounding, carrying into the mantissa
+    extend = extend_t(newlo >> (64 - EXTEND_BITS));
+    extend_t rounded = extend_t(extend + round);
+    mantissa = newhi + (rounded < extend);
+    extend = rounded;
 }
 
 
@@ -744,7 +1042,7 @@ inline void fpextxx_t<ExtendedType>::normalize()
 // add two values of the same sign, assuming src1 is the larger value
 //
 template<typename ExtendedType>
-inline void fpextxx_t<ExtendedType>::add_values(fpextxx_t const &src1, fpextxx_t const &src2, int src2shift)
+inline constexpr void fpextxx_t<ExtendedType>::add_values(fpextxx_t const &src1, fpextxx_t const &src2, int src2shift)
 {
     // if src2 is way too small, treat as zero
     if (src2shift >= MANTISSA_BITS)
@@ -756,69 +1054,29 @@ inline void fpextxx_t<ExtendedType>::add_values(fpextxx_t const &src1, fpextxx_t
     }
 
     // shift the second value
-    extend_t src2e;
     mantissa_t src2m;
-    if (src2shift == 0)
-    {
-        src2e = src2.m_extend;
-        src2m = src2.m_mantissa;
-    }
-    else if (src2shift < EXTEND_BITS)
-    {
-        src2e = extend_t((src2.m_extend >> src2shift) | (src2.m_mantissa << (EXTEND_BITS - src2shift)));
-        src2m = src2.m_mantissa >> src2shift;
-        if (((src2.m_extend & (1 << (src2shift - 1))) != 0) && ++src2e == 0) src2m++;
-    }
-    else
-    {
-        src2e = extend_t(src2.m_mantissa >> (src2shift - EXTEND_BITS));
-        src2m = (src2shift < 64) ? (src2.m_mantissa >> src2shift) : 0;
-        if (src2shift != EXTEND_BITS && ((src2.m_mantissa & (1ull << (src2shift - EXTEND_BITS - 1))) != 0) && ++src2e == 0) src2m++;
-    }
+    extend_t src2e;
+    src2.shift_operand_right(src2shift, src2m, src2e);
 
     // add the main mantissa and note carry out
-    m_mantissa = src1.m_mantissa + src2m;
+    mantissa_t mantissa = src1.m_mantissa + src2m;
+    bool carry = (mantissa < src2m);
+
+    // add the extension
+    extend_t extend = extend_t(src1.m_extend + src2e);
     m_exponent = src1.m_exponent;
-    bool carry = (m_mantissa < src2m);
+    m_mantissa = mantissa;
+    m_extend = extend;
 
-    // add the extension and handle carry out
-    m_extend = src1.m_extend + src2e;
-    if (m_extend < src2e)
+    // handle carry out of the extension; this can only overflow the
+    // mantissa when there was no carry out of the main add
+    if (extend < src2e)
         this->round_mantissa_up();
 
-    // handle carry out
-    if (carry)
-    {
-        this->shift_mantissa_right(1);
-        m_mantissa |= EXPLICIT_ONE;
-        m_exponent += 1;
-    }
-}
-
-template<>
-inline void fpextxx_t<uint8_t>::add_values(fpextxx_t const &src1, fpextxx_t const &src2, int src2shift)
-{
-    // if src2 is way too small, treat as zero
-    if (src2shift >= MANTISSA_BITS)
-    {
-        m_mantissa = src1.m_mantissa;
-        m_exponent = src1.m_exponent;
-        return;
-    }
-
-    // shift the second value
-    mantissa_t src2m = src2.m_mantissa >> src2shift;
-    if (src2shift != 0 && (src2.m_mantissa & (1ull << (src2shift - 1))) != 0) src2m++;
-
-    // add and handle overflow
-    m_mantissa = src1.m_mantissa + src2m;
-    m_exponent = src1.m_exponent;
-    if (m_mantissa < src2m)
-    {
-        this->shift_mantissa_right(1);
-        m_mantissa |= EXPLICIT_ONE;
-        m_exponent += 1;
-    }
+    // handle carry out of the main add
+    m_extend = extend_t((m_extend >> carry) | ((m_mantissa & carry) << (EXTEND_BITS - 1)));
+    m_mantissa = (m_mantissa >> carry) | (mantissa_t(carry) << 63);
+    m_exponent += carry;
 }
 
 
@@ -827,7 +1085,7 @@ inline void fpextxx_t<uint8_t>::add_values(fpextxx_t const &src1, fpextxx_t cons
 // subtract the source mantissa, normalizing
 //
 template<typename ExtendedType>
-inline void fpextxx_t<ExtendedType>::sub_values(fpextxx_t const &src1, fpextxx_t const &src2, int src2shift)
+inline constexpr void fpextxx_t<ExtendedType>::sub_values(fpextxx_t const &src1, fpextxx_t const &src2, int src2shift)
 {
     // if src2 is way too small, treat as zero
     if (src2shift >= MANTISSA_BITS)
@@ -839,57 +1097,15 @@ inline void fpextxx_t<ExtendedType>::sub_values(fpextxx_t const &src1, fpextxx_t
     }
 
     // shift the second value
-    extend_t src2e;
     mantissa_t src2m;
-    if (src2shift == 0)
-    {
-        src2e = src2.m_extend;
-        src2m = src2.m_mantissa;
-    }
-    else if (src2shift < EXTEND_BITS)
-    {
-        src2e = extend_t((src2.m_extend >> src2shift) | (src2.m_mantissa << (EXTEND_BITS - src2shift)));
-        src2m = src2.m_mantissa >> src2shift;
-        if (((src2.m_extend & (1 << (src2shift - 1))) != 0) && ++src2e == 0) src2m++;
-    }
-    else
-    {
-        src2e = extend_t(src2.m_mantissa >> (src2shift - EXTEND_BITS));
-        src2m = (src2shift < 64) ? (src2.m_mantissa >> src2shift) : 0;
-        if (src2shift != EXTEND_BITS && ((src2.m_mantissa & (1ull << (src2shift - EXTEND_BITS - 1))) != 0) && ++src2e == 0) src2m++;
-    }
-
-    // subtract the main mantissa
-    m_mantissa = src1.m_mantissa - src2m;
-    m_exponent = src1.m_exponent;
-
-    // subtract the extension and borrow
-    auto orig = src1.m_extend;
-    m_extend = orig - src2e;
-    if (m_extend > orig)
-        m_mantissa--;
-
-    // normalize
-    this->normalize();
-}
-
-template<>
-inline void fpextxx_t<uint8_t>::sub_values(fpextxx_t const &src1, fpextxx_t const &src2, int src2shift)
-{
-    // if src2 is way too small, treat as zero
-    if (src2shift >= MANTISSA_BITS)
-    {
-        m_mantissa = src1.m_mantissa;
-        m_exponent = src1.m_exponent;
-        return;
-    }
-
-    // shift the second value
-    mantissa_t src2m = src2.m_mantissa >> src2shift;
-    if (src2shift != 0 && (src2.m_mantissa & (1ull << (src2shift - 1))) != 0) src2m++;
+    extend_t src2e;
+    src2.shift_operand_right(src2shift, src2m, src2e);
 
-    // subtract
-    m_mantissa = src1.m_mantissa - src2m;
+    // subtract the extension and main mantissa, borrowing between them
+    extend_t orig = src1.m_extend;
+    extend_t extend = extend_t(orig - src2e);
+    m_mantissa = src1.m_mantissa - src2m - (extend > orig);
+    m_extend = extend;
     m_exponent = src1.m_exponent;
 
     // normalize
@@ -902,7 +1118,7 @@ inline void fpextxx_t<uint8_t>::sub_values(fpextxx_t const &src1, fpextxx_t cons
 // equality comparisons
 //
 template<typename ExtendedType>
-inline bool fpextxx_t<ExtendedType>::operator==(fpextxx_t const &rhs) const
+inline constexpr bool fpextxx_t<ExtendedType>::operator==(fpextxx_t const &rhs) const
 {
     return (m_mantissa == rhs.m_mantissa &&
             (!EXTENDED || m_extend == rhs.m_extend) &&
@@ -911,7 +1127,7 @@ inline bool fpextxx_t<ExtendedType>::operator==(fpextxx_t const &rhs) const
 }
 
 template<typename ExtendedType>
-inline bool fpextxx_t<ExtendedType>::operator!=(fpextxx_t const &rhs) const
+inline constexpr bool fpextxx_t<ExtendedType>::operator!=(fpextxx_t const &rhs) const
 {
     return (m_mantissa != rhs.m_mantissa ||
             (EXTENDED && m_extend != rhs.m_extend) ||
@@ -925,7 +1141,7 @@ inline bool fpextxx_t<ExtendedType>::operator!=(fpextxx_t const &rhs) const
 // less than comparisons
 //
 template<typename ExtendedType>
-inline bool fpextxx_t<ExtendedType>::operator<(fpextxx_t const &rhs) const
+inline constexpr bool fpextxx_t<ExtendedType>::operator<(fpextxx_t const &rhs) const
 {
     if ((m_sign ^ rhs.m_sign) != 0)
         return m_sign;
@@ -943,7 +1159,7 @@ inline bool fpextxx_t<ExtendedType>::operator<(fpextxx_t const &rhs) const
 }
 
 template<typename ExtendedType>
-inline bool fpextxx_t<ExtendedType>::operator<=(fpextxx_t const &rhs) const
+inline constexpr bool fpextxx_t<ExtendedType>::operator<=(fpextxx_t const &rhs) const
 {
     if ((m_sign ^ rhs.m_sign) != 0)
         return m_sign;
@@ -966,7 +1182,7 @@ inline bool fpextxx_t<ExtendedType>::operator<=(fpextxx_t const &rhs) const
 // greater than comparisons
 //
 template<typename ExtendedType>
-inline bool fpextxx_t<ExtendedType>::operator>(fpextxx_t const &rhs) const
+inline constexpr bool fpextxx_t<ExtendedType>::operator>(fpextxx_t const &rhs) const
 {
     if ((m_sign ^ rhs.m_sign) != 0)
         return rhs.m_sign;
@@ -984,7 +1200,7 @@ inline bool fpextxx_t<ExtendedType>::operator>(fpextxx_t const &rhs) const
 }
 
 template<typename ExtendedType>
-inline bool fpextxx_t<ExtendedType>::operator>=(fpextxx_t const &rhs) const
+inline constexpr bool fpextxx_t<ExtendedType>::operator>=(fpextxx_t const &rhs) const
 {
     if ((m_sign ^ rhs.m_sign) != 0)
         return rhs.m_sign;
@@ -1007,7 +1223,7 @@ inline bool fpextxx_t<ExtendedType>::operator>=(fpextxx_t const &rhs) const
 // perform addition between two source values
 //
 template<typename ExtendedType>
-inline void fpextxx_t<ExtendedType>::add(fpextxx_t const &a, fpextxx_t const &b)
+inline constexpr void fpextxx_t<ExtendedType>::add(fpextxx_t const &a, fpextxx_t const &b)
 {
     // get difference in signs
     sign_t signdiff = a.m_sign ^ b.m_sign;
@@ -1057,7 +1273,7 @@ inline void fpextxx_t<ExtendedType>::add(fpextxx_t const &a, fpextxx_t const &b)
 // perform subtraction between two source values
 //
 template<typename ExtendedType>
-inline void fpextxx_t<ExtendedType>::sub(fpextxx_t const &a, fpextxx_t const &b)
+inline constexpr void fpextxx_t<ExtendedType>::sub(fpextxx_t const &a, fpextxx_t const &b)
 {
     // get difference in signs
     sign_t signdiff = a.m_sign ^ b.m_sign;
@@ -1103,11 +1319,63 @@ inline void fpextxx_t<ExtendedType>::sub(fpextxx_t const &a, fpextxx_t const &b)
 
 
 
+//
+// fpext64_t fast path for addition and subtraction: with no extension
+// there is little enough work that both the sum and the normalized
+// difference can be computed and the right one selected, so the operand
+// order, the signs and the exponent gap never need to be branched on
+//
+template<>
+inline constexpr void fpextxx_t<uint8_t>::add(fpextxx_t const &a, fpextxx_t const &b)
+{
+    // order by magnitude; equal exponents are ordered by mantissa so that
+    // the difference can't go negative
+    exponent_t dexp = a.m_exponent - b.m_exponent;
+    bool swap = (dexp < 0) | ((dexp == 0) & (a.m_mantissa < b.m_mantissa));
+    mantissa_t src1m = select64(swap, b.m_mantissa, a.m_mantissa);
+    mantissa_t src2m = select64(swap, a.m_mantissa, b.m_mantissa);
+    exponent_t exponent = exponent_t(select64(swap, b.m_exponent, a.m_exponent));
+    sign_t sign = sign_t(select64(swap, b.m_sign, a.m_sign));
+    bool subtract = (a.m_sign != b.m_sign);
+    int src2shift = int(select64(swap, -dexp, dexp));
+
+    // shift the second value, rounding by the last bit shifted out; a value
+    // that is way too small shifts out entirely and is treated as zero
+    int count = src2shift & 63;
+    uint64_t round = (src2m >> ((count - 1) & 63)) & uint64_t(count != 0);
+    src2m = select64(src2shift < MANTISSA_BITS, (src2m >> count) + round, 0);
+
+    // add and fold any carry back into the top bit
+    mantissa_t sum = src1m + src2m;
+    bool carry = (sum < src2m);
+    mantissa_t summ = (sum >> carry) | (mantissa_t(carry) << 63);
+
+    // subtract and normalize
+    mantissa_t diff = src1m - src2m;
+    int shift = count_leading_zeros64(diff | 1);
+    exponent_t diffexp = exponent_t(select64(diff == 0, uint64_t(EXPONENT_MIN), exponent - shift));
+
+    // select the result
+    m_mantissa = select64(subtract, diff << shift, summ);
+    m_exponent = exponent_t(select64(subtract, diffexp, exponent + carry));
+    m_sign = sign;
+}
+
+template<>
+inline constexpr void fpextxx_t<uint8_t>::sub(fpextxx_t const &a, fpextxx_t const &b)
+{
+    fpextxx_t negb = b;
+    negb.m_sign ^= 1;
+    this->add(a, negb);
+}
+
+
+
 //
 // perform multiplication between two source values
 //
 template<typename ExtendedType>
-inline void fpextxx_t<ExtendedType>::mul(fpextxx_t const &a, fpextxx_t const &b)
+inline constexpr void fpextxx_t<ExtendedType>::mul(fpextxx_t const &a, fpextxx_t const &b)
 {
     // compute final sign
     m_sign = a.m_sign ^ b.m_sign;
@@ -1121,23 +1389,57 @@ inline void fpextxx_t<ExtendedType>::mul(fpextxx_t const &a, fpextxx_t const &b)
         return;
     }
 
-    // compute 64x64 mantissa multiplication
-    auto [lo, hi] = multiply_64x64(a.m_mantissa, b.m_mantissa);
-
-    // compute A.hi * B.lo and B.hi * A.lo
-    auto [lo1, hi1] = multiply_64x64(a.m_mantissa, uint32_t(b.m_extend << (32 - EXTEND_BITS)));
-    auto [lo2, hi2] = multiply_64x64(b.m_mantissa, uint32_t(a.m_extend << (32 - EXTEND_BITS)));
-
-    // add upper parts; guaranteed not to overflow (max 64+32 bits each)
-    uint64_t hiadd = hi1 + hi2;
-
-    // add lower parts; carry into upper part
-    uint64_t loadd = lo1 + lo2;
-    if (loadd < lo2)
-        hiadd++;
+    // compute the top 128 bits of the product
+    uint64_t lo, hi;
+    multiply_mantissas(a, b, lo, hi);
 
-    // also compute A.lo * B.lo
-    uint64_t lo3 = (uint64_t(a.m_extend) * uint64_t(b.m_extend)) >> (EXTEND_BITS*2 - 32);
+    // compute final exponent
+    m_exponent = a.m_exponent + b.m_exponent;
+
+    // adjust for overflow
+    if ((hi & EXPLICIT_ONE) == 0)
+    {
+        m_mantissa = (hi << 1) | (lo >> 63);
+        m_extend = extend_t(lo >> (63 - EXTEND_BITS));
+        if ((lo & (1ull << (63 - EXTEND_BITS - 1))) != 0) this->round_extend_up();
+    }
+    else
+    {
+        m_mantissa = hi;
+        m_extend = extend_t(lo >> (64 - EXTEND_BITS));
+        m_exponent += 1;
+        if ((lo & (1ull << (64 - EXTEND_BITS - 1))) != 0) this->round_extend_up();
+    }
+
+    // double check to be sure we ended up as expected
+    x87_assert((m_mantissa & EXPLICIT_ONE) != 0);
+}
+
+//
+// compute the top 128 bits of the product of two mantissas, as a 2.126 value
+//
+template<typename ExtendedType>
+inline constexpr void fpextxx_t<ExtendedType>::multiply_mantissas(fpextxx_t const &a, fpextxx_t const &b, uint64_t &lo, uint64_t &hi)
+{
+    // compute 64x64 mantissa multiplication
+    auto [mullo, mulhi] = multiply_64x64(a.m_mantissa, b.m_mantissa);
+    lo = mullo;
+    hi = mulhi;
+
+    // compute A.hi * B.lo and B.hi * A.lo
+    auto [lo1, hi1] = multiply_64x64(a.m_mantissa, uint32_t(b.m_extend << (32 - EXTEND_BITS)));
+    auto [lo2, hi2] = multiply_64x64(b.m_mantissa, uint32_t(a.m_extend << (32 - EXTEND_BITS)));
+
+    // add upper parts; guaranteed not to overflow (max 64+32 bits each)
+    uint64_t hiadd = hi1 + hi2;
+
+    // add lower parts; carry into upper part
+    uint64_t loadd = lo1 + lo2;
+    if (loadd < lo2)
+        hiadd++;
+
+    // also compute A.lo * B.lo
+    uint64_t lo3 = (uint64_t(a.m_extend) * uint64_t(b.m_extend)) >> (EXTEND_BITS*2 - 32);
 
     // add in this contribution, carrying into hi
     loadd += lo3;
@@ -1153,31 +1455,77 @@ inline void fpextxx_t<ExtendedType>::mul(fpextxx_t const &a, fpextxx_t const &b)
     if (lo < loadd)
         hi++;
     hi += hiadd;
+}
+
+template<>
+inline constexpr void fpextxx_t<uint8_t>::multiply_mantissas(fpextxx_t const &a, fpextxx_t const &b, uint64_t &lo, uint64_t &hi)
+{
+    auto [mullo, mulhi] = multiply_64x64(a.m_mantissa, b.m_mantissa);
+    lo = mullo;
+    hi = mulhi;
+}
+
+template<>
+inline constexpr void fpextxx_t<uint16_t>::multiply_mantissas(fpextxx_t const &a, fpextxx_t const &b, uint64_t &lo, uint64_t &hi)
+{
+    // compute 64x64 mantissa multiplication
+    auto [mullo, mulhi] = multiply_64x64(a.m_mantissa, b.m_mantissa);
+    lo = mullo;
+    hi = mulhi;
+
+    // with only 16 extension bits, the cross products can be formed from
+    // 32-bit halves of the mantissas in plain 64-bit multiplies; each sum
+    // is under 49 bits, so nothing overflows
+    uint64_t crosshi = (a.m_mantissa >> 32) * b.m_extend + (b.m_mantissa >> 32) * a.m_extend;
+    uint64_t crosslo = uint32_t(a.m_mantissa) * uint64_t(b.m_extend) + uint32_t(b.m_mantissa) * uint64_t(a.m_extend);
+
+    // fold in the high 16 bits of A.lo * B.lo, then shift the low half of
+    // the cross products down to line up with crosshi
+    crosslo += (uint32_t(a.m_extend) * uint32_t(b.m_extend)) >> 16;
+    uint64_t loadd = (crosshi << 16) + (crosslo >> 16);
+    uint64_t hiadd = (crosshi >> 48) + (loadd < (crosshi << 16));
+
+    // add to the lower part and carry if necessary
+    lo += loadd;
+    hi += hiadd + (lo < loadd);
+}
+
+template<>
+inline constexpr void fpextxx_t<uint8_t>::mul(fpextxx_t const &a, fpextxx_t const &b)
+{
+    // compute final sign
+    m_sign = a.m_sign ^ b.m_sign;
+
+    // check for 0
+    if (a.iszero() || b.iszero())
+    {
+        m_exponent = EXPONENT_MIN;
+        m_mantissa = 0;
+        return;
+    }
+
+    // compute 64x64 mantissa multiplication
+    auto [lo, hi] = multiply_64x64(a.m_mantissa, b.m_mantissa);
 
     // compute final exponent
     m_exponent = a.m_exponent + b.m_exponent;
 
     // adjust for overflow
     if ((hi & EXPLICIT_ONE) == 0)
-    {
-        m_mantissa = (hi << 1) | (lo >> 63);
-        m_extend = extend_t(lo >> (63 - EXTEND_BITS));
-        if ((lo & (1ull << (63 - EXTEND_BITS - 1))) != 0) this->round_extend_up();
-    }
+        m_mantissa = ((hi << 1) | (lo >> 63)) + ((lo >> 62) & 1);
     else
-    {
-        m_mantissa = hi;
-        m_extend = extend_t(lo >> (64 - EXTEND_BITS));
-        m_exponent += 1;
-        if ((lo & (1ull << (64 - EXTEND_BITS - 1))) != 0) this->round_extend_up();
-    }
+        m_mantissa = hi + ((lo >> 63) & 1), m_exponent += 1;
+
+    // rounding can carry out of an all-ones mantissa
+    if (m_mantissa == 0)
+        m_mantissa = EXPLICIT_ONE, m_exponent += 1;
 
     // double check to be sure we ended up as expected
     x87_assert((m_mantissa & EXPLICIT_ONE) != 0);
 }
 
 template<>
-inline void fpextxx_t<uint8_t>::mul(fpextxx_t const &a, fpextxx_t const &b)
+inline constexpr void fpextxx_t<uint64_t>::mul(fpextxx_t const &a, fpextxx_t const &b)
 {
     // compute final sign
     m_sign = a.m_sign ^ b.m_sign;
@@ -1187,20 +1535,49 @@ inline void fpextxx_t<uint8_t>::mul(fpextxx_t const &a, fpextxx_t const &b)
     {
         m_exponent = EXPONENT_MIN;
         m_mantissa = 0;
+        m_extend = 0;
         return;
     }
 
-    // compute 64x64 mantissa multiplication
+    // compute the four 64x64 partial products
     auto [lo, hi] = multiply_64x64(a.m_mantissa, b.m_mantissa);
+    auto [lo1, hi1] = multiply_64x64(a.m_mantissa, b.m_extend);
+    auto [lo2, hi2] = multiply_64x64(b.m_mantissa, a.m_extend);
+    auto [lo3, hi3] = multiply_64x64(a.m_extend, b.m_extend);
+
+    // sum the middle word; only its carries and top bits matter
+    uint64_t mid = hi3 + lo1;
+    uint64_t carry = (mid < lo1);
+    mid += lo2;
+    carry += (mid < lo2);
+
+    // add the cross terms and carries into the low word of A.hi * B.hi
+    uint64_t hicarry = 0;
+    lo += carry;
+    hicarry += (lo < carry);
+    lo += hi1;
+    hicarry += (lo < hi1);
+    lo += hi2;
+    hicarry += (lo < hi2);
+    hi += hicarry;
 
     // compute final exponent
     m_exponent = a.m_exponent + b.m_exponent;
 
     // adjust for overflow
     if ((hi & EXPLICIT_ONE) == 0)
-        m_mantissa = ((hi << 1) | (lo >> 63)) + ((lo >> 62) & 1);
+    {
+        m_mantissa = (hi << 1) | (lo >> 63);
+        m_extend = (lo << 1) | (mid >> 63);
+        if ((mid & (1ull << 62)) != 0) this->round_extend_up();
+    }
     else
-        m_mantissa = hi + ((lo >> 63) & 1), m_exponent += 1;
+    {
+        m_mantissa = hi;
+        m_extend = lo;
+        m_exponent += 1;
+        if ((mid & (1ull << 63)) != 0) this->round_extend_up();
+    }
 
     // double check to be sure we ended up as expected
     x87_assert((m_mantissa & EXPLICIT_ONE) != 0);
@@ -1208,11 +1585,150 @@ inline void fpextxx_t<uint8_t>::mul(fpextxx_t const &a, fpextxx_t const &b)
 
 
 
+//
+// perform a fused multiply-add; the product is kept as an unrounded 2.126
+// value, c is aligned against it, and the sum is normalized and rounded
+// once. Leaving the product unnormalized means the alignment doesn't have
+// to wait for the multiply. Bits shifted out past the 128-bit window are
+// dropped, which is far below the final rounding for all but the 64-bit
+// extension, so fpext128_t keeps the separate multiply and add
+//
+template<typename ExtendedType>
+inline constexpr fpextxx_t<ExtendedType> fpextxx_t<ExtendedType>::fma(fpextxx_t const &a, fpextxx_t const &b, fpextxx_t const &c)
+{
+    if constexpr (EXTEND_BITS == 64)
+    {
+        fpextxx_t res;
+        res.mul(a, b);
+        res.add(res, c);
+        return res;
+    }
+    else
+    {
+        // zeros fall back to the plain operations
+        if (a.iszero() || b.iszero() || c.iszero())
+            return a * b + c;
+
+        // compute the 128-bit product as a 2.126 value
+        uint64_t prodlo, prodhi;
+        multiply_mantissas(a, b, prodlo, prodhi);
+        exponent_t prodexp = a.m_exponent + b.m_exponent + 1;
+        sign_t prodsign = a.m_sign ^ b.m_sign;
+
+        // widen c to the same form
+        uint64_t addhi = c.m_mantissa;
+        uint64_t addlo = EXTENDED ? (uint64_t(c.m_extend) << (64 - EXTEND_BITS)) : 0;
+
+        // align whichever has the smaller exponent against the other
+        exponent_t dexp = prodexp - c.m_exponent;
+        exponent_t exp = prodexp;
+        bool swapped = (dexp < 0);
+        if (swapped)
+        {
+            std::swap(prodhi, addhi);
+            std::swap(prodlo, addlo);
+            exp = c.m_exponent;
+            dexp = -dexp;
+        }
+        if (dexp >= 128)
+            addhi = addlo = 0;
+        else if (dexp >= 64)
+        {
+            addlo = addhi >> (dexp - 64);
+            addhi = 0;
+        }
+        else if (dexp != 0)
+        {
+            addlo = (addlo >> dexp) | (addhi << (64 - dexp));
+            addhi >>= dexp;
+        }
+
+        // add the 128-bit values, handling carry out
+        uint64_t hi, lo;
+        sign_t sign = prodsign;
+        if (prodsign == c.m_sign)
+        {
+            lo = prodlo + addlo;
+            uint64_t carry = (lo < addlo);
+            hi = prodhi + addhi;
+            bool overflow = (hi < addhi);
+            hi += carry;
+            overflow |= (hi < carry);
+            if (overflow)
+            {
+                lo = (lo >> 1) | (hi << 63);
+                hi = (hi >> 1) | EXPLICIT_ONE;
+                exp += 1;
+            }
+        }
+
+        // or subtract them, negating if the result went negative
+        else
+        {
+            lo = prodlo - addlo;
+            uint64_t borrow = (prodlo < addlo);
+            hi = prodhi - addhi;
+            bool negative = (prodhi < addhi) || (hi < borrow);
+            hi -= borrow;
+            if (negative)
+            {
+                lo = -lo;
+                hi = ~hi + (lo == 0);
+            }
+            sign = sign_t(prodsign ^ (negative ^ swapped));
+
+            // cancellation can reach into the low word
+            if (hi == 0)
+            {
+                if (lo == 0)
+                    return from_parts(0, 0, EXPONENT_MIN, sign);
+                hi = lo;
+                lo = 0;
+                exp -= 64;
+            }
+        }
+
+        // normalize; the unnormalized product can leave a zero top bit even
+        // without cancellation
+        int lz = count_leading_zeros64(hi);
+        if (lz != 0)
+        {
+            hi = (hi << lz) | (lo >> (64 - lz));
+            lo <<= lz;
+            exp -= lz;
+        }
+
+        // round once to the final precision
+        fpextxx_t result = from_parts(hi, extend_t(EXTENDED ? (lo >> (64 - EXTEND_BITS)) : 0), exp, sign);
+        if (!EXTENDED)
+        {
+            if ((lo >> 63) != 0)
+                result.round_mantissa_up();
+        }
+        else if (((lo >> (63 - EXTEND_BITS)) & 1) != 0)
+            result.round_extend_up();
+        return result;
+    }
+}
+
+
+
+//
+// perform division between two source values
+//
+template<typename ExtendedType>
+inline constexpr void fpextxx_t<ExtendedType>::div(fpextxx_t const &a, fpextxx_t const &b)
+{
+    this->mul(a, recip(b));
+}
+
+
+
 //
 // compute the floor of a value
 //
 template<typename ExtendedType>
-inline fpextxx_t<ExtendedType> fpextxx_t<ExtendedType>::floor(fpextxx_t const &a)
+inline constexpr fpextxx_t<ExtendedType> fpextxx_t<ExtendedType>::floor(fpextxx_t const &a)
 {
     mantissa_t mantissa = a.mantissa();
     extend_t extend = a.extend();
@@ -1229,9 +1745,9 @@ inline fpextxx_t<ExtendedType> fpextxx_t<ExtendedType>::floor(fpextxx_t const &a
         if (exp <= MANTISSA_BITS - 1)
         {
             int shift = MANTISSA_BITS - 1 - exp;
-            extend_t extend_mask = (shift < EXTEND_BITS) ? ~((1 << shift) - 1) : 0;
+            extend_t extend_mask = (shift < EXTEND_BITS) ? extend_t(~((extend_t(1) << shift) - 1)) : 0;
             mantissa_t mantissa_mask = (shift > EXTEND_BITS) ? ~((1ull << (shift - EXTEND_BITS)) - 1) : ~0ull;
-            return fpextxx_t(mantissa & mantissa_mask, extend & extend_mask, exp, 0);
+            return from_parts(mantissa & mantissa_mask, extend & extend_mask, exp, 0);
         }
 
         // large exponents have nothing to floor
@@ -1249,14 +1765,16 @@ inline fpextxx_t<ExtendedType> fpextxx_t<ExtendedType>::floor(fpextxx_t const &a
         if (exp <= MANTISSA_BITS - 1)
         {
             int shift = MANTISSA_BITS - 1 - exp;
-            extend_t extend_mask = (shift < EXTEND_BITS) ? ~((1 << shift) - 1) : 0;
+            extend_t extend_mask = (shift < EXTEND_BITS) ? extend_t(~((extend_t(1) << shift) - 1)) : 0;
             mantissa_t mantissa_mask = (shift > EXTEND_BITS) ? ~((1ull << (shift - EXTEND_BITS)) - 1) : ~0ull;
-            extend_t extend_sum = extend + ~extend_mask;
+            extend_t extend_sum = extend_t(extend + extend_t(~extend_mask));
             mantissa_t mantissa_sum = mantissa + ~mantissa_mask + (extend_sum < extend);
+
+            // a carry out means the masked sum is exactly the next power of 2
             if (mantissa_sum < mantissa)
-                return fpextxx_t<uint8_t>(((mantissa_sum & mantissa_mask) >> 1) | EXPLICIT_ONE, extend_t((extend_sum >> 1) | (mantissa_sum << (EXTEND_BITS - 1))), exp + 1, 1);
+                return from_parts(EXPLICIT_ONE, 0, exp + 1, 1);
             else
-                return fpextxx_t(mantissa_sum & mantissa_mask, extend_sum & extend_mask, exp, 1);
+                return from_parts(mantissa_sum & mantissa_mask, extend_sum & extend_mask, exp, 1);
         }
 
         // large exponents have nothing to floor
@@ -1265,7 +1783,7 @@ inline fpextxx_t<ExtendedType> fpextxx_t<ExtendedType>::floor(fpextxx_t const &a
 }
 
 template<>
-inline fpextxx_t<uint8_t> fpextxx_t<uint8_t>::floor(fpextxx_t const &a)
+inline constexpr fpextxx_t<uint8_t> fpextxx_t<uint8_t>::floor(fpextxx_t const &a)
 {
     mantissa_t mantissa = a.mantissa();
     exponent_t exp = a.exponent();
@@ -1320,7 +1838,7 @@ inline fpextxx_t<uint8_t> fpextxx_t<uint8_t>::floor(fpextxx_t const &a)
 // the low integral bits (used for trig functions)
 //
 template<typename ExtendedType>
-inline fpextxx_t<ExtendedType> fpextxx_t<ExtendedType>::floor_abs_loint(fpextxx_t const &a, uint64_t &intbits)
+inline constexpr fpextxx_t<ExtendedType> fpextxx_t<ExtendedType>::floor_abs_loint(fpextxx_t const &a, uint64_t &intbits)
 {
     mantissa_t mantissa = a.mantissa();
     extend_t extend = a.extend();
@@ -1342,17 +1860,17 @@ inline fpextxx_t<ExtendedType> fpextxx_t<ExtendedType>::floor_abs_loint(fpextxx_
         shift -= EXTEND_BITS;
         mantissa_t mantissa_mask = ~((1ull << shift) - 1);
         intbits = mantissa >> shift;
-        return fpextxx_t(mantissa & mantissa_mask, 0, exp, 0);
+        return from_parts(mantissa & mantissa_mask, 0, exp, 0);
     }
 
     // mask only extend bits
-    extend_t extend_mask = ~((1 << shift) - 1);
+    extend_t extend_mask = extend_t(~((extend_t(1) << shift) - 1));
     intbits = int64_t((extend >> shift) | (mantissa << (EXTEND_BITS - shift)));
-    return fpextxx_t(mantissa, extend & extend_mask, exp, 0);
+    return from_parts(mantissa, extend & extend_mask, exp, 0);
 }
 
 template<>
-inline fpextxx_t<uint8_t> fpextxx_t<uint8_t>::floor_abs_loint(fpextxx_t const &a, uint64_t &intbits)
+inline constexpr fpextxx_t<uint8_t> fpextxx_t<uint8_t>::floor_abs_loint(fpextxx_t const &a, uint64_t &intbits)
 {
     mantissa_t mantissa = a.mantissa();
     exponent_t exp = a.exponent();
@@ -1373,6 +1891,474 @@ inline fpextxx_t<uint8_t> fpextxx_t<uint8_t>::floor_abs_loint(fpextxx_t const &a
     return fpextxx_t<uint8_t>(mantissa & mantissa_mask, 0, exp, 0);
 }
 
+
+
+//
+// compute the reciprocal of a non-zero value
+//
+template<typename ExtendedType>
+inline constexpr fpextxx_t<ExtendedType> fpextxx_t<ExtendedType>::recip(fpextxx_t const &a)
+{
+    x87_assert(!a.iszero());
+
+    // estimate 1/m in double precision, with m = |a| scaled to [1,2)
+    fpextxx_t m = from_parts(a.m_mantissa, a.m_extend, 0, 0);
+    fpextxx_t y(1.0 / m.as_double());
+
+    // each Newton step y += y * (1 - m * y) doubles the number of good bits
+    for (int bits = 53; bits < MANTISSA_BITS; bits *= 2)
+        y += y * (one - m * y);
+
+    // apply the exponent and sign
+    y.m_exponent -= a.m_exponent;
+    y.m_sign = a.m_sign;
+    return y;
+}
+
+
+
+//
+// compute the reciprocal square root of a positive value
+//
+template<typename ExtendedType>
+inline fpextxx_t<ExtendedType> fpextxx_t<ExtendedType>::rsqrt(fpextxx_t const &a)
+{
+    x87_assert(!a.iszero() && a.m_sign == 0);
+
+    // estimate 1/sqrt(m) in double precision, with m = a scaled by an
+    // even power of 2 to [1,4)
+    exponent_t half = a.m_exponent >> 1;
+    fpextxx_t m = from_parts(a.m_mantissa, a.m_extend, a.m_exponent - 2 * half, 0);
+    fpextxx_t y(1.0 / std::sqrt(m.as_double()));
+
+    // each Newton step y += y * (1 - m * y * y) / 2 doubles the number of good bits
+    for (int bits = 53; bits < MANTISSA_BITS; bits *= 2)
+        y += ldexp(y * (one - m * y * y), -1);
+
+    // apply the exponent
+    y.m_exponent -= half;
+    return y;
+}
+
+
+
+//
+// parse a decimal string such as "-1.2345e-6"; this is meant for building
+// constants and tables at compile time, and is accurate to a few ulps
+//
+template<typename ExtendedType>
+inline constexpr fpextxx_t<ExtendedType> fpextxx_t<ExtendedType>::from_string(char const *str)
+{
+    // optional sign
+    sign_t sign = 0;
+    if (*str == '-' || *str == '+')
+        sign = (*str++ == '-');
+
+    // accumulate the digits in chunks of up to 19, which are exact in 64 bits
+    fpextxx_t result = zero;
+    uint64_t chunk = 0;
+    uint64_t chunkscale = 1;
+    auto flush_chunk = [&]()
+    {
+        fpextxx_t scale = from_parts(chunkscale, 0, 63, 0);
+        fpextxx_t digits = from_parts(chunk, 0, 63, 0);
+        scale.normalize();
+        digits.normalize();
+        result = result * scale + digits;
+        chunk = 0;
+        chunkscale = 1;
+    };
+    int32_t dexp = 0;
+    bool point = false;
+    for ( ; (*str >= '0' && *str <= '9') || *str == '.'; str++)
+    {
+        if (*str == '.')
+            point = true;
+        else
+        {
+            chunk = chunk * 10 + (*str - '0');
+            chunkscale *= 10;
+            dexp -= point;
+            if (chunkscale == 10000000000000000000ull)
+                flush_chunk();
+        }
+    }
+    if (chunkscale != 1)
+        flush_chunk();
+
+    // optional exponent
+    if (*str == 'e' || *str == 'E')
+    {
+        str++;
+        bool negexp = (*str == '-');
+        if (*str == '-' || *str == '+')
+            str++;
+        int32_t exp = 0;
+        for ( ; *str >= '0' && *str <= '9'; str++)
+            exp = exp * 10 + (*str - '0');
+        dexp += negexp ? -exp : exp;
+    }
+
+    // apply the power of 10, built by squaring
+    fpextxx_t scale = one;
+    fpextxx_t power = from_parts(0xa000000000000000ull, 0, 3, 0);
+    for (uint32_t count = (dexp < 0) ? -dexp : dexp; count != 0; count >>= 1, power *= power)
+        if ((count & 1) != 0)
+            scale *= power;
+    result = (dexp < 0) ? result / scale : result * scale;
+    result.m_sign = sign;
+    return result;
+}
+
+
+
+//
+// construct an fpext106_t from an fpextxx_t
+//
+template<typename SrcExtendedType>
+fpext106_t::fpext106_t(fpextxx_t<SrcExtendedType> const &src) :
+    fpext106_t(from_mantissa(src.mantissa(), uint64_t(src.extend()) << (64 - 8 * sizeof(SrcExtendedType)), src.exponent(), src.sign()))
+{
+}
+
+
+
+//
+// construct an fpext106_t from an fp80 type
+//
+inline fpext106_t::fpext106_t(fp80_t const &src) :
+    fpext106_t(fpext96_t(src))
+{
+}
+
+
+
+//
+// convert an fpext106_t to an fp80
+//
+inline fp80_t fpext106_t::as_fp80() const
+{
+    // zeros have no exploded form, so convert those directly
+    if (this->iszero())
+        return fp80_t(m_hi);
+    exploded_t parts = this->explode();
+    return fpext96_t(parts.mantissa, uint32_t(parts.extend >> 32), parts.exponent, this->sign()).as_fp80();
+}
+
+
+
+//
+// split an fpext106_t into an exponent and a 1.127 mantissa
+//
+inline fpext106_t::exploded_t fpext106_t::explode() const
+{
+    if (this->iszero())
+        return { 0, 0, EXPONENT_MIN };
+
+    // the high part supplies the top 53 bits
+    fpext64_t hi{fp64_t(m_hi)};
+    exploded_t result = { hi.mantissa(), 0, hi.exponent() };
+    if (m_lo == 0)
+        return result;
+
+    // line up the low part's 53 bits below that; since it is at most half
+    // an ulp of the high part, the shift is never more than 11
+    fpext64_t lo{fp64_t(m_lo)};
+    int shift = lo.exponent() - hi.exponent() + 64;
+    uint64_t addhi = 0;
+    uint64_t addlo = 0;
+    if (shift > 0)
+    {
+        addlo = lo.mantissa() << shift;
+        addhi = lo.mantissa() >> (64 - shift);
+    }
+    else if (shift > -64)
+        addlo = lo.mantissa() >> -shift;
+
+    // add or subtract based on the relative signs; subtracting can borrow
+    // at most one bit of normalization
+    if (std::signbit(m_lo) == std::signbit(m_hi))
+    {
+        result.extend += addlo;
+        result.mantissa += addhi + (result.extend < addlo);
+    }
+    else
+    {
+        result.mantissa -= addhi + (result.extend < addlo);
+        result.extend -= addlo;
+        if ((result.mantissa & EXPLICIT_ONE) == 0)
+        {
+            result.mantissa = (result.mantissa << 1) | (result.extend >> 63);
+            result.extend <<= 1;
+            result.exponent -= 1;
+        }
+    }
+    return result;
+}
+
+
+
+//
+// assemble an fpext106_t from a 1.127 mantissa, exponent and sign
+//
+inline constexpr fpext106_t fpext106_t::from_mantissa(uint64_t high, uint64_t low, int32_t exponent, uint16_t sign)
+{
+    if (high == 0)
+        return sign ? nzero : zero;
+
+    // the high part is the top 53 bits rounded to nearest, and the low part
+    // is the signed remainder of the next 64 bits
+    uint64_t rest = (high << 53) | (low >> 11);
+    uint64_t himan = (high >> 11) + (rest >> 63);
+    double hi = scale(double(himan), exponent - 52);
+    double lo = scale(double(int64_t(rest)), exponent - 116);
+    return sign ? fpext106_t(-hi, -lo) : fpext106_t(hi, lo);
+}
+
+
+
+//
+// multiply a double by 2^exponent; this uses powers of two built from
+// their bits, in steps if needed, so that it can be constexpr
+//
+inline constexpr double fpext106_t::scale(double value, int32_t exponent)
+{
+    exponent = (exponent < -2200) ? -2200 : (exponent > 2100) ? 2100 : exponent;
+    for ( ; exponent > FP64_EXPONENT_BIAS; exponent -= FP64_EXPONENT_BIAS)
+        value *= std::bit_cast<double>(uint64_t(2 * FP64_EXPONENT_BIAS) << FP64_EXPONENT_SHIFT);
+    for ( ; exponent < 1 - FP64_EXPONENT_BIAS; exponent += FP64_EXPONENT_BIAS - 1)
+        value *= std::bit_cast<double>(uint64_t(1) << FP64_EXPONENT_SHIFT);
+    return value * std::bit_cast<double>(uint64_t(exponent + FP64_EXPONENT_BIAS) << FP64_EXPONENT_SHIFT);
+}
+
+
+
+//
+// perform addition between two source values
+//
+inline void fpext106_t::add(fpext106_t const &a, fpext106_t const &b)
+{
+    // sum the high and low parts separately, then fold the errors back in
+    fpext106_t s = two_sum(a.m_hi, b.m_hi);
+    fpext106_t t = two_sum(a.m_lo, b.m_lo);
+    s = quick_two_sum(s.m_hi, s.m_lo + t.m_hi);
+    *this = quick_two_sum(s.m_hi, s.m_lo + t.m_lo);
+}
+
+
+
+//
+// perform subtraction between two source values
+//
+inline void fpext106_t::sub(fpext106_t const &a, fpext106_t const &b)
+{
+    fpext106_t s = two_sum(a.m_hi, -b.m_hi);
+    fpext106_t t = two_sum(a.m_lo, -b.m_lo);
+    s = quick_two_sum(s.m_hi, s.m_lo + t.m_hi);
+    *this = quick_two_sum(s.m_hi, s.m_lo + t.m_lo);
+}
+
+
+
+//
+// perform multiplication between two source values
+//
+inline void fpext106_t::mul(fpext106_t const &a, fpext106_t const &b)
+{
+    // the high product is exact thanks to fma; the cross terms only need
+    // double precision, and lo * lo is below the result's precision
+    fpext106_t p = two_prod(a.m_hi, b.m_hi);
+    *this = quick_two_sum(p.m_hi, p.m_lo + (a.m_hi * b.m_lo + a.m_lo * b.m_hi));
+}
+
+
+
+//
+// perform division between two source values
+//
+inline void fpext106_t::div(fpext106_t const &a, fpext106_t const &b)
+{
+    x87_assert(!b.iszero());
+
+    // long division by the high part of b, one double of quotient at a time,
+    // with the remainders computed exactly
+    double q1 = a.m_hi / b.m_hi;
+    fpext106_t r = a - b * fpext106_t(q1);
+    double q2 = r.m_hi / b.m_hi;
+    r -= b * fpext106_t(q2);
+    double q3 = r.m_hi / b.m_hi;
+    *this = quick_two_sum(q1, q2) + fpext106_t(q3);
+}
+
+
+
+//
+// compute the floor of a value
+//
+inline fpext106_t fpext106_t::floor(fpext106_t const &a)
+{
+    // if the high part is not an integer, the low part is too small to
+    // move the result past the next integer down
+    double hi = std::floor(a.m_hi);
+    if (hi != a.m_hi)
+        return fpext106_t(hi, 0.0);
+    return quick_two_sum(hi, std::floor(a.m_lo));
+}
+
+
+
+//
+// compute the floor the absolute value of a number, plus return
+// the low integral bits (used for trig functions)
+//
+inline fpext106_t fpext106_t::floor_abs_loint(fpext106_t const &a, uint64_t &intbits)
+{
+    x87_assert(std::abs(a.m_hi) < 9223372036854775808.0);
+
+    fpext106_t res = a;
+    res = floor(res.abs());
+    intbits = uint64_t(res.m_hi) + uint64_t(int64_t(res.m_lo));
+    return res;
+}
+
+
+
+//
+// compute the reciprocal square root of a positive value
+//
+inline fpext106_t fpext106_t::rsqrt(fpext106_t const &a)
+{
+    x87_assert(a.m_hi > 0);
+
+    // the double estimate is good to 53 bits, so a single Newton step
+    // y += y * (1 - a * y * y) / 2 is enough
+    fpext106_t y(1.0 / std::sqrt(a.m_hi));
+    return y + ldexp(y * (one - a * y * y), -1);
+}
+
+
+
+//===========================================================================
+//
+// exp2m1_table
+//
+// Build a table of 2^(k/R) - 1 for k = -R..R at compile time. 2^(+/-1/R)
+// comes from the Taylor series of e^(x*ln(2)) in 128 bits, and each entry
+// is a running product of those, rounded once to the result type.
+//
+//===========================================================================
+
+template<typename ResultType, int R>
+constexpr std::array<ResultType, 2 * R + 1> exp2m1_table()
+{
+    fpext128_t const ln2 = fpext128_t::from_string("0.693147180559945309417232121458176568075500134360255254120680009");
+    fpext128_t const x = ln2 / fpext128_t(double(R));
+
+    // sum the series for both signs of x at once
+    fpext128_t up = fpext128_t::one;
+    fpext128_t down = fpext128_t::one;
+    fpext128_t term = fpext128_t::one;
+    for (int n = 1; term.exponent() > -140; n++)
+    {
+        term = term * x / fpext128_t(double(n));
+        up += term;
+        if ((n & 1) != 0)
+            down -= term;
+        else
+            down += term;
+    }
+
+    // accumulate powers outward from the center
+    std::array<ResultType, 2 * R + 1> result;
+    result[R] = ResultType::zero;
+    fpext128_t upk = fpext128_t::one;
+    fpext128_t downk = fpext128_t::one;
+    for (int k = 1; k <= R; k++)
+    {
+        upk *= up;
+        downk *= down;
+        result[R + k] = ResultType(upk - fpext128_t::one, true);
+        result[R - k] = ResultType(downk - fpext128_t::one, true);
+    }
+    return result;
+}
+
+
+
+//===========================================================================
+//
+// fpext_table_t
+//
+// Read-only table of fpextxx_t constants, stored as separate arrays of
+// mantissas, extensions and packed sign/exponents rather than as padded
+// values. An fpext64_t entry shrinks from 16 bytes to 10 and an fpext96_t
+// entry from 24 to 14, so a table spans fewer cache lines; entries are
+// reassembled into an fpextxx_t when loaded.
+//
+//===========================================================================
+
+template<typename ExtendedType, size_t Count>
+class fpext_table_t
+{
+public:
+    using value_type = fpextxx_t<ExtendedType>;
+
+    //
+    // packed exponents are biased like fp80_t, with a field of 0 for zero
+    //
+    static constexpr int32_t EXPONENT_BIAS = 0x3fff;
+
+    //
+    // construct from an array of values
+    //
+    constexpr fpext_table_t(std::array<value_type, Count> const &src) :
+        m_mantissa{},
+        m_extend{},
+        m_sign_exp{}
+    {
+        for (size_t index = 0; index < Count; index++)
+        {
+            value_type const &val = src[index];
+            int32_t exp = val.iszero() ? -EXPONENT_BIAS : val.exponent();
+            x87_assert(exp >= -EXPONENT_BIAS && exp <= EXPONENT_BIAS);
+            m_mantissa[index] = val.m_mantissa;
+            if constexpr (value_type::EXTENDED)
+                m_extend[index] = val.m_extend;
+            m_sign_exp[index] = uint16_t((val.m_sign << 15) | (exp + EXPONENT_BIAS));
+        }
+    }
+
+    //
+    // size and element access
+    //
+    static constexpr size_t size() { return Count; }
+    constexpr value_type operator[](size_t index) const
+    {
+        uint16_t sign_exp = m_sign_exp[index];
+        int32_t exp = int32_t(sign_exp & 0x7fff) - EXPONENT_BIAS;
+        return value_type::from_parts(m_mantissa[index], value_type::EXTENDED ? m_extend[index] : 0,
+            (exp == -EXPONENT_BIAS) ? value_type::EXPONENT_MIN : exp, sign_exp >> 15);
+    }
+
+    //
+    // raw arrays, for gathers; the sign/exponent array has one entry of
+    // padding so that it can be gathered 32 bits at a time
+    //
+    constexpr uint64_t const *mantissas() const { return m_mantissa.data(); }
+    constexpr uint16_t const *sign_exponents() const { return m_sign_exp.data(); }
+
+private:
+    //
+    // internal state
+    //
+    std::array<uint64_t, Count> m_mantissa;
+    std::array<ExtendedType, value_type::EXTENDED ? Count : 0> m_extend;
+    std::array<uint16_t, Count + 1> m_sign_exp;
+};
+
+template<typename ExtendedType, size_t Count>
+fpext_table_t(std::array<fpextxx_t<ExtendedType>, Count> const &) -> fpext_table_t<ExtendedType, Count>;
+
 }
 
 #endif
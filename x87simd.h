@@ -0,0 +1,570 @@
+//=========================================================
+//  x87simd.h
+//
+//  Vector helpers shared by the batch implementations.
+//=========================================================
+//
+// BSD 3-Clause License
+//
+// Copyright (c) 2025, Aaron Giles
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+
+#pragma once
+
+#ifndef X87SIMD_H
+#define X87SIMD_H
+
+#include "x87common.h"
+#include "x87fpext.h"
+
+#if X87_SIMD_X64
+#include <immintrin.h>
+#endif
+
+
+//===========================================================================
+//
+// AVX2 helpers
+//
+// Generic operations on 4 64-bit lanes. All helpers carry the AVX2 target
+// attribute so that they can be inlined into both the AVX2 and AVX-512
+// versions of the batch loops.
+//
+//===========================================================================
+
+#if X87_SIMD_X64
+
+namespace x87
+{
+
+//
+// OR together the 4 64-bit lanes of a vector
+//
+X87_TARGET_AVX2 inline uint64_t reduce_or4(__m256i value)
+{
+    __m128i temp = _mm_or_si128(_mm256_castsi256_si128(value), _mm256_extracti128_si256(value, 1));
+    return uint64_t(_mm_cvtsi128_si64(_mm_or_si128(temp, _mm_unpackhi_epi64(temp, temp))));
+}
+
+//
+// return a mask of lanes where a < b, treating both as unsigned
+//
+X87_TARGET_AVX2 inline __m256i cmplt_epu64_x4(__m256i a, __m256i b)
+{
+    __m256i const bias = _mm256_set1_epi64x(0x8000000000000000ll);
+    return _mm256_cmpgt_epi64(_mm256_xor_si256(b, bias), _mm256_xor_si256(a, bias));
+}
+
+//
+// count leading zeros of 4 nonzero 64-bit values without lzcnt; each 32-bit
+// half is converted exactly to a double via the 2^52 trick and the leading
+// zero count is read from the resulting exponent. Sources narrower than 64
+// bits only need the low half
+//
+template<typename Type>
+X87_TARGET_AVX2 inline __m256i clz_x4_avx2(__m256i value)
+{
+    __m256i const magic = _mm256_set1_epi64x(0x4330000000000000ll);
+    __m256i const lomask = _mm256_set1_epi64x(0xffffffff);
+    __m256i const clzbase = _mm256_set1_epi64x(32 + 1023 + 31);
+
+    __m256d lo = _mm256_sub_pd(_mm256_castsi256_pd(_mm256_or_si256(_mm256_and_si256(value, lomask), magic)), _mm256_castsi256_pd(magic));
+    __m256i result = _mm256_sub_epi64(clzbase, _mm256_srli_epi64(_mm256_castpd_si256(lo), 52));
+    if constexpr (sizeof(Type) == 8)
+    {
+        __m256i hibits = _mm256_srli_epi64(value, 32);
+        __m256d hi = _mm256_sub_pd(_mm256_castsi256_pd(_mm256_or_si256(hibits, magic)), _mm256_castsi256_pd(magic));
+        __m256i hiclz = _mm256_sub_epi64(_mm256_set1_epi64x(1023 + 31), _mm256_srli_epi64(_mm256_castpd_si256(hi), 52));
+        result = _mm256_blendv_epi8(hiclz, result, _mm256_cmpeq_epi64(hibits, _mm256_setzero_si256()));
+    }
+    return result;
+}
+
+//
+// convert 4 signed 64-bit integers to doubles; only valid for values whose
+// magnitude is below 2^51, where adding to 1.5*2^52 is exact
+//
+X87_TARGET_AVX2 inline __m256d cvtepi64_pd_small_x4(__m256i value)
+{
+    __m256d const magic = _mm256_set1_pd(6755399441055744.0);
+    return _mm256_sub_pd(_mm256_castsi256_pd(_mm256_add_epi64(value, _mm256_castpd_si256(magic))), magic);
+}
+
+//
+// convert 4 unsigned 64-bit integers to correctly rounded doubles; each
+// 32-bit half converts exactly and the final add rounds once
+//
+X87_TARGET_AVX2 inline __m256d cvtepu64_pd_x4(__m256i value)
+{
+    __m256i const magic = _mm256_set1_epi64x(0x4330000000000000ll);
+    __m256d hi = _mm256_sub_pd(_mm256_castsi256_pd(_mm256_or_si256(_mm256_srli_epi64(value, 32), magic)), _mm256_castsi256_pd(magic));
+    __m256d lo = _mm256_sub_pd(_mm256_castsi256_pd(_mm256_or_si256(_mm256_and_si256(value, _mm256_set1_epi64x(0xffffffff)), magic)), _mm256_castsi256_pd(magic));
+    return _mm256_add_pd(_mm256_mul_pd(hi, _mm256_set1_pd(4294967296.0)), lo);
+}
+
+//
+// perform 4 64x64-bit multiplications, returning the low and high halves
+// of the 128-bit results; built from 32x32-bit partial products
+//
+X87_TARGET_AVX2 inline void multiply_64x64_x4(__m256i a, __m256i b, __m256i &lo, __m256i &hi)
+{
+    __m256i const lomask = _mm256_set1_epi64x(0xffffffff);
+    __m256i ahi = _mm256_srli_epi64(a, 32);
+    __m256i bhi = _mm256_srli_epi64(b, 32);
+    __m256i ll = _mm256_mul_epu32(a, b);
+    __m256i lh = _mm256_mul_epu32(a, bhi);
+    __m256i hl = _mm256_mul_epu32(ahi, b);
+    __m256i hh = _mm256_mul_epu32(ahi, bhi);
+
+    // the middle sum can't overflow 64 bits
+    __m256i mid = _mm256_add_epi64(_mm256_srli_epi64(ll, 32), _mm256_add_epi64(_mm256_and_si256(lh, lomask), _mm256_and_si256(hl, lomask)));
+    lo = _mm256_or_si256(_mm256_and_si256(ll, lomask), _mm256_slli_epi64(mid, 32));
+    hi = _mm256_add_epi64(_mm256_add_epi64(hh, _mm256_srli_epi64(mid, 32)), _mm256_add_epi64(_mm256_srli_epi64(lh, 32), _mm256_srli_epi64(hl, 32)));
+}
+
+
+
+//===========================================================================
+//
+// Double-double helpers
+//
+// 4-lane versions of the fpext106_t error-free transformations, with each
+// lane held as separate hi and lo vectors. AVX2 has no FMA, so two_prod_x4
+// recovers the product error with a Dekker split instead; both are exact,
+// so the results match the scalar code as long as no lane overflows.
+//
+//===========================================================================
+
+//
+// compute hi + lo = a + b exactly, requiring |a| >= |b|
+//
+X87_TARGET_AVX2 inline void quick_two_sum_x4(__m256d a, __m256d b, __m256d &hi, __m256d &lo)
+{
+    hi = _mm256_add_pd(a, b);
+    lo = _mm256_sub_pd(b, _mm256_sub_pd(hi, a));
+}
+
+//
+// compute hi + lo = a + b exactly
+//
+X87_TARGET_AVX2 inline void two_sum_x4(__m256d a, __m256d b, __m256d &hi, __m256d &lo)
+{
+    hi = _mm256_add_pd(a, b);
+    __m256d bb = _mm256_sub_pd(hi, a);
+    lo = _mm256_add_pd(_mm256_sub_pd(a, _mm256_sub_pd(hi, bb)), _mm256_sub_pd(b, bb));
+}
+
+//
+// compute hi + lo = a * b exactly
+//
+X87_TARGET_AVX2 inline void two_prod_x4(__m256d a, __m256d b, __m256d &hi, __m256d &lo)
+{
+    __m256d const split = _mm256_set1_pd(134217729.0);
+    __m256d at = _mm256_mul_pd(a, split);
+    __m256d ahi = _mm256_sub_pd(at, _mm256_sub_pd(at, a));
+    __m256d alo = _mm256_sub_pd(a, ahi);
+    __m256d bt = _mm256_mul_pd(b, split);
+    __m256d bhi = _mm256_sub_pd(bt, _mm256_sub_pd(bt, b));
+    __m256d blo = _mm256_sub_pd(b, bhi);
+    hi = _mm256_mul_pd(a, b);
+    lo = _mm256_add_pd(_mm256_add_pd(_mm256_add_pd(_mm256_sub_pd(_mm256_mul_pd(ahi, bhi), hi), _mm256_mul_pd(ahi, blo)), _mm256_mul_pd(alo, bhi)), _mm256_mul_pd(alo, blo));
+}
+
+//
+// multiply two double-doubles the same way as fpext106_t::mul
+//
+X87_TARGET_AVX2 inline void mul_dd_x4(__m256d ahi, __m256d alo, __m256d bhi, __m256d blo, __m256d &hi, __m256d &lo)
+{
+    __m256d phi, plo;
+    two_prod_x4(ahi, bhi, phi, plo);
+    quick_two_sum_x4(phi, _mm256_add_pd(plo, _mm256_add_pd(_mm256_mul_pd(ahi, blo), _mm256_mul_pd(alo, bhi))), hi, lo);
+}
+
+//
+// convert a double-double to a double the same way as fpext106_t::as_fp64,
+// truncating toward zero
+//
+X87_TARGET_AVX2 inline __m256d truncate_dd_x4(__m256d hi, __m256d lo)
+{
+    __m256i hibits = _mm256_castpd_si256(hi);
+    __m256i signdiff = _mm256_cmpgt_epi64(_mm256_setzero_si256(), _mm256_xor_si256(hibits, _mm256_castpd_si256(lo)));
+    __m256i nonzero = _mm256_castpd_si256(_mm256_cmp_pd(lo, _mm256_setzero_pd(), _CMP_NEQ_OQ));
+    return _mm256_castsi256_pd(_mm256_add_epi64(hibits, _mm256_and_si256(signdiff, nonzero)));
+}
+
+
+
+//===========================================================================
+//
+// Classification helpers
+//
+// Per-lane special-value tests shared by the batch kernels. The slowpath
+// helpers return a mask of lanes that aren't normal, finite, nonzero values
+// and so need the scalar code; the fxam helpers return the C3/C2/C1/C0 bits
+// that FXAM would report for each lane.
+//
+//===========================================================================
+
+//
+// return a mask of fp64 lanes that are zero, denormal, infinite, or NaN
+//
+X87_TARGET_AVX2 inline __m256i slowpath_fp64_x4(__m256i bits)
+{
+    __m256i const expmask = _mm256_set1_epi64x(FP64_EXPONENT_MASK);
+    __m256i exponent = _mm256_and_si256(bits, expmask);
+    return _mm256_or_si256(_mm256_cmpeq_epi64(exponent, _mm256_setzero_si256()), _mm256_cmpeq_epi64(exponent, expmask));
+}
+
+//
+// return a mask of fp80 lanes that are zero, denormal, infinite, NaN, or
+// unsupported (explicit one clear with a nonzero exponent); sign_exp holds
+// the 16-bit sign/exponent zero-extended to 64 bits
+//
+X87_TARGET_AVX2 inline __m256i slowpath_fp80_x4(__m256i mantissa, __m256i sign_exp)
+{
+    __m256i const expmask = _mm256_set1_epi64x(FP80_EXPONENT_MASK);
+    __m256i exponent = _mm256_and_si256(sign_exp, expmask);
+    __m256i special = _mm256_or_si256(_mm256_cmpeq_epi64(exponent, _mm256_setzero_si256()), _mm256_cmpeq_epi64(exponent, expmask));
+    return _mm256_or_si256(special, _mm256_cmpgt_epi64(_mm256_setzero_si256(), _mm256_xor_si256(mantissa, _mm256_set1_epi64x(FP80_EXPLICIT_ONE))));
+}
+
+//
+// FXAM class codes for 4 fp64 lanes: zero (C3), infinity (C2|C0), NaN (C0),
+// or normal (C2); C1 is the sign. Denormals report as normal, as they do
+// once loaded into an 80-bit register
+//
+X87_TARGET_AVX2 inline __m256i fxam_fp64_x4(__m256i bits)
+{
+    __m256i const zero = _mm256_setzero_si256();
+    __m256i const expmask = _mm256_set1_epi64x(FP64_EXPONENT_MASK);
+    __m256i exponent = _mm256_and_si256(bits, expmask);
+    __m256i minexp = _mm256_cmpeq_epi64(exponent, zero);
+    __m256i maxexp = _mm256_cmpeq_epi64(exponent, expmask);
+    __m256i fraczero = _mm256_cmpeq_epi64(_mm256_and_si256(bits, _mm256_set1_epi64x(FP64_MANTISSA_MASK)), zero);
+
+    // C2 is set except for zeros and NaNs
+    __m256i noc2 = _mm256_or_si256(_mm256_and_si256(minexp, fraczero), _mm256_andnot_si256(fraczero, maxexp));
+    __m256i result = _mm256_andnot_si256(noc2, _mm256_set1_epi64x(X87SW_C2));
+    result = _mm256_or_si256(result, _mm256_and_si256(_mm256_and_si256(minexp, fraczero), _mm256_set1_epi64x(X87SW_C3)));
+    result = _mm256_or_si256(result, _mm256_and_si256(maxexp, _mm256_set1_epi64x(X87SW_C0)));
+    return _mm256_or_si256(result, _mm256_slli_epi64(_mm256_srli_epi64(bits, FP64_SIGN_SHIFT), X87SW_C1_BIT));
+}
+
+//
+// FXAM class codes for 4 fp80 lanes: zero (C3), denormal (C3|C2), infinity
+// (C2|C0), NaN (C0), normal (C2), or unsupported (nothing) for a nonzero
+// exponent without the explicit one; pseudo-denormals report as denormal
+// and C1 is the sign
+//
+X87_TARGET_AVX2 inline __m256i fxam_fp80_x4(__m256i mantissa, __m256i sign_exp)
+{
+    __m256i const zero = _mm256_setzero_si256();
+    __m256i const expmask = _mm256_set1_epi64x(FP80_EXPONENT_MASK);
+    __m256i exponent = _mm256_and_si256(sign_exp, expmask);
+    __m256i minexp = _mm256_cmpeq_epi64(exponent, zero);
+    __m256i maxexp = _mm256_cmpeq_epi64(exponent, expmask);
+    __m256i fraczero = _mm256_cmpeq_epi64(_mm256_and_si256(mantissa, _mm256_set1_epi64x(FP80_MANTISSA_MASK)), zero);
+    __m256i unsupported = _mm256_andnot_si256(minexp, _mm256_cmpgt_epi64(zero, _mm256_xor_si256(mantissa, _mm256_set1_epi64x(FP80_EXPLICIT_ONE))));
+
+    // C2 is set except for zeros and NaNs
+    __m256i noc2 = _mm256_or_si256(_mm256_and_si256(minexp, _mm256_cmpeq_epi64(mantissa, zero)), _mm256_andnot_si256(fraczero, maxexp));
+    __m256i result = _mm256_andnot_si256(noc2, _mm256_set1_epi64x(X87SW_C2));
+    result = _mm256_or_si256(result, _mm256_and_si256(minexp, _mm256_set1_epi64x(X87SW_C3)));
+    result = _mm256_or_si256(result, _mm256_and_si256(maxexp, _mm256_set1_epi64x(X87SW_C0)));
+    result = _mm256_andnot_si256(unsupported, result);
+    return _mm256_or_si256(result, _mm256_slli_epi64(_mm256_srli_epi64(sign_exp, FP80_SIGN_SHIFT), X87SW_C1_BIT));
+}
+
+
+
+
+//===========================================================================
+//
+// fpext64x4_t
+//
+// Four fpext64_t values, split into separate vectors of mantissas, exponents
+// and signs. Each operation follows the scalar fpextxx_t<uint8_t> code step
+// for step, so the results are bit-identical to it.
+//
+//===========================================================================
+
+class fpext64x4_t
+{
+public:
+    //
+    // construct from the individual parts
+    //
+    X87_TARGET_AVX2 explicit fpext64x4_t(__m256i mantissa, __m256i exponent, __m256i sign) :
+        m_mantissa(mantissa),
+        m_exponent(exponent),
+        m_sign(sign)
+    {
+    }
+
+    //
+    // broadcast a single value to all 4 lanes
+    //
+    X87_TARGET_AVX2 explicit fpext64x4_t(fpext64_t const &src) :
+        m_mantissa(_mm256_set1_epi64x(int64_t(src.mantissa()))),
+        m_exponent(_mm256_set1_epi64x(src.exponent())),
+        m_sign(_mm256_set1_epi64x(src.sign()))
+    {
+    }
+
+    //
+    // gather 4 entries from a packed table, unpacking the sign/exponents
+    //
+    template<size_t Count>
+    X87_TARGET_AVX2 explicit fpext64x4_t(fpext_table_t<uint8_t, Count> const &table, __m256i index)
+    {
+        using table_t = fpext_table_t<uint8_t, Count>;
+        __m128i sign_exp32 = _mm256_i64gather_epi32(reinterpret_cast<int const *>(table.sign_exponents()), index, 2);
+        __m256i sign_exp = _mm256_and_si256(_mm256_cvtepu32_epi64(sign_exp32), _mm256_set1_epi64x(0xffff));
+        __m256i expfield = _mm256_and_si256(sign_exp, _mm256_set1_epi64x(0x7fff));
+        m_mantissa = _mm256_i64gather_epi64(reinterpret_cast<long long const *>(table.mantissas()), index, 8);
+        m_exponent = _mm256_blendv_epi8(_mm256_sub_epi64(expfield, _mm256_set1_epi64x(table_t::EXPONENT_BIAS)),
+            _mm256_set1_epi64x(fpext64_t::EXPONENT_MIN), _mm256_cmpeq_epi64(expfield, _mm256_setzero_si256()));
+        m_sign = _mm256_srli_epi64(sign_exp, 15);
+    }
+
+    //
+    // convert from 4 fp64 values, which must not be infinities or NaNs
+    //
+    X87_TARGET_AVX2 explicit fpext64x4_t(__m256d src)
+    {
+        __m256i bits = _mm256_castpd_si256(src);
+        __m256i expfield = _mm256_srli_epi64(_mm256_and_si256(bits, _mm256_set1_epi64x(FP64_EXPONENT_MASK)), FP64_EXPONENT_SHIFT);
+        __m256i denorm = _mm256_cmpeq_epi64(expfield, _mm256_setzero_si256());
+
+        // insert the explicit one for normal numbers; denorms and zeros
+        // get an exponent of 1 - bias and are normalized below
+        m_mantissa = _mm256_or_si256(_mm256_slli_epi64(_mm256_and_si256(bits, _mm256_set1_epi64x(FP64_MANTISSA_MASK)), 63 - FP64_EXPONENT_SHIFT), _mm256_andnot_si256(denorm, _mm256_set1_epi64x(int64_t(fpext64_t::EXPLICIT_ONE))));
+        m_exponent = _mm256_sub_epi64(_mm256_sub_epi64(expfield, _mm256_set1_epi64x(FP64_EXPONENT_BIAS)), denorm);
+        m_sign = _mm256_srli_epi64(bits, FP64_SIGN_SHIFT);
+        if (_mm256_movemask_pd(_mm256_castsi256_pd(denorm)) != 0)
+        {
+            fpext64x4_t normalized = normalize(m_mantissa, m_exponent, m_sign);
+            m_mantissa = _mm256_blendv_epi8(m_mantissa, normalized.m_mantissa, denorm);
+            m_exponent = _mm256_blendv_epi8(m_exponent, normalized.m_exponent, denorm);
+        }
+    }
+
+    //
+    // convert to fp64 values, truncating like as_fp64()
+    //
+    X87_TARGET_AVX2 __m256d as_fp64() const
+    {
+        __m256i exp = _mm256_add_epi64(m_exponent, _mm256_set1_epi64x(FP64_EXPONENT_BIAS));
+        __m256i result = _mm256_slli_epi64(m_sign, FP64_SIGN_SHIFT);
+
+        // denormals and zeros both fall out of the variable shift, since
+        // shifts of 64 or more produce 0
+        __m256i denorm = _mm256_srlv_epi64(m_mantissa, _mm256_sub_epi64(_mm256_set1_epi64x(64 - FP64_EXPONENT_SHIFT), exp));
+        __m256i normal = _mm256_or_si256(_mm256_slli_epi64(exp, FP64_EXPONENT_SHIFT),
+            _mm256_and_si256(_mm256_srli_epi64(m_mantissa, 63 - FP64_EXPONENT_SHIFT), _mm256_set1_epi64x(FP64_MANTISSA_MASK)));
+        __m256i bits = _mm256_blendv_epi8(denorm, normal, _mm256_cmpgt_epi64(exp, _mm256_setzero_si256()));
+        bits = _mm256_blendv_epi8(bits, _mm256_set1_epi64x(FP64_EXPONENT_MASK), _mm256_cmpgt_epi64(exp, _mm256_set1_epi64x(FP64_EXPONENT_MAX_BIASED - 1)));
+        return _mm256_castsi256_pd(_mm256_or_si256(result, bits));
+    }
+
+    //
+    // perform multiplication between two source values
+    //
+    X87_TARGET_AVX2 static fpext64x4_t mul(fpext64x4_t const &a, fpext64x4_t const &b)
+    {
+        __m256i const one = _mm256_set1_epi64x(1);
+
+        // compute 64x64 mantissa multiplication and the final exponent
+        __m256i lo, hi;
+        multiply_64x64_x4(a.m_mantissa, b.m_mantissa, lo, hi);
+        __m256i exponent = _mm256_add_epi64(a.m_exponent, b.m_exponent);
+
+        // adjust for overflow
+        __m256i lotop = _mm256_srli_epi64(lo, 63);
+        __m256i shifted = _mm256_add_epi64(_mm256_or_si256(_mm256_slli_epi64(hi, 1), lotop), _mm256_and_si256(_mm256_srli_epi64(lo, 62), one));
+        __m256i overflow = _mm256_cmpgt_epi64(_mm256_setzero_si256(), hi);
+        __m256i mantissa = _mm256_blendv_epi8(shifted, _mm256_add_epi64(hi, lotop), overflow);
+        exponent = _mm256_sub_epi64(exponent, overflow);
+
+        // check for 0
+        __m256i zero = _mm256_or_si256(_mm256_cmpeq_epi64(a.m_mantissa, _mm256_setzero_si256()), _mm256_cmpeq_epi64(b.m_mantissa, _mm256_setzero_si256()));
+        return fpext64x4_t(_mm256_andnot_si256(zero, mantissa),
+            _mm256_blendv_epi8(exponent, _mm256_set1_epi64x(fpext64_t::EXPONENT_MIN), zero),
+            _mm256_xor_si256(a.m_sign, b.m_sign));
+    }
+
+    //
+    // perform addition between two source values
+    //
+    X87_TARGET_AVX2 static fpext64x4_t add(fpext64x4_t const &a, fpext64x4_t const &b)
+    {
+        __m256i const zero = _mm256_setzero_si256();
+        __m256i const one = _mm256_set1_epi64x(1);
+
+        // pick the larger value: by exponent, then by mantissa if the signs differ
+        __m256i samesign = _mm256_cmpeq_epi64(a.m_sign, b.m_sign);
+        __m256i dexp = _mm256_sub_epi64(a.m_exponent, b.m_exponent);
+        __m256i pick_a = _mm256_or_si256(_mm256_cmpgt_epi64(dexp, zero),
+            _mm256_and_si256(_mm256_cmpeq_epi64(dexp, zero), _mm256_or_si256(samesign, _mm256_xor_si256(cmplt_epu64_x4(a.m_mantissa, b.m_mantissa), _mm256_set1_epi64x(-1)))));
+        __m256i src1m = _mm256_blendv_epi8(b.m_mantissa, a.m_mantissa, pick_a);
+        __m256i src1e = _mm256_blendv_epi8(b.m_exponent, a.m_exponent, pick_a);
+        __m256i src1s = _mm256_blendv_epi8(b.m_sign, a.m_sign, pick_a);
+        __m256i src2m = _mm256_blendv_epi8(a.m_mantissa, b.m_mantissa, pick_a);
+        __m256i shift = _mm256_blendv_epi8(_mm256_sub_epi64(zero, dexp), dexp, pick_a);
+
+        // shift the second value, rounding by the last bit shifted out; a
+        // shift of 0 produces a count of -1, which shifts everything out
+        __m256i round = _mm256_and_si256(_mm256_srlv_epi64(src2m, _mm256_sub_epi64(shift, one)), one);
+        src2m = _mm256_add_epi64(_mm256_srlv_epi64(src2m, shift), round);
+
+        // add and handle overflow
+        __m256i summ = _mm256_add_epi64(src1m, src2m);
+        __m256i carry = cmplt_epu64_x4(summ, src2m);
+        summ = _mm256_blendv_epi8(summ, _mm256_or_si256(_mm256_srli_epi64(summ, 1), _mm256_set1_epi64x(int64_t(fpext64_t::EXPLICIT_ONE))), carry);
+        __m256i sume = _mm256_sub_epi64(src1e, carry);
+
+        // subtract and normalize
+        fpext64x4_t diff = normalize(_mm256_sub_epi64(src1m, src2m), src1e, src1s);
+
+        // if src2 is way too small, treat as zero
+        __m256i toosmall = _mm256_cmpgt_epi64(shift, _mm256_set1_epi64x(63));
+        __m256i mantissa = _mm256_blendv_epi8(diff.m_mantissa, summ, samesign);
+        __m256i exponent = _mm256_blendv_epi8(diff.m_exponent, sume, samesign);
+        return fpext64x4_t(_mm256_blendv_epi8(mantissa, src1m, toosmall), _mm256_blendv_epi8(exponent, src1e, toosmall), src1s);
+    }
+
+    //
+    // perform subtraction between two source values
+    //
+    X87_TARGET_AVX2 static fpext64x4_t sub(fpext64x4_t const &a, fpext64x4_t const &b)
+    {
+        return add(a, fpext64x4_t(b.m_mantissa, b.m_exponent, _mm256_xor_si256(b.m_sign, _mm256_set1_epi64x(1))));
+    }
+
+    //
+    // normalize a denormalized or zero value
+    //
+    X87_TARGET_AVX2 static fpext64x4_t normalize(__m256i mantissa, __m256i exponent, __m256i sign)
+    {
+        __m256i zero = _mm256_cmpeq_epi64(mantissa, _mm256_setzero_si256());
+        __m256i shift = clz_x4_avx2<uint64_t>(mantissa);
+        return fpext64x4_t(_mm256_sllv_epi64(mantissa, shift),
+            _mm256_blendv_epi8(_mm256_sub_epi64(exponent, shift), _mm256_set1_epi64x(fpext64_t::EXPONENT_MIN), zero),
+            sign);
+    }
+
+    //
+    // raw parts
+    //
+    __m256i m_mantissa;
+    __m256i m_exponent;
+    __m256i m_sign;
+};
+}
+
+#endif
+
+
+
+//===========================================================================
+//
+// run_batch
+//
+// Common driver for batch operations. Each operation supplies a kernel
+// class with these static members:
+//
+//    uint16_t scalar(size_t index, Args... args)
+//       process the single element at index, returning its flags
+//
+//    X87_TARGET_AVX2 __m256i avx2(size_t index, __m256i &flags, Args... args)
+//       process the 4 elements starting at index, ORing the flags for the
+//       lanes it handled into flags, and returning a mask of the lanes that
+//       must be redone by scalar()
+//
+// The driver takes care of stepping through groups of 4, redoing special
+// lanes, the leftover elements, reducing the flags, and choosing between
+// the AVX2 and scalar loops for the host.
+//
+//===========================================================================
+
+namespace x87
+{
+
+//
+// scalar loop over elements index..count-1
+//
+template<typename Kernel, typename... Args>
+inline uint16_t run_batch_scalar(size_t index, size_t count, Args... args)
+{
+    uint16_t flags = 0;
+    for ( ; index < count; index++)
+        flags |= Kernel::scalar(index, args...);
+    return flags;
+}
+
+#if X87_SIMD_X64
+
+//
+// AVX2 loop; the vector flags are only reduced once at the end
+//
+template<typename Kernel, typename... Args>
+X87_TARGET_AVX2 inline uint16_t run_batch_avx2(size_t count, Args... args)
+{
+    __m256i flags = _mm256_setzero_si256();
+    uint16_t scalar_flags = 0;
+    size_t index = 0;
+    for ( ; index + 4 <= count; index += 4)
+    {
+        __m256i special = Kernel::avx2(index, flags, args...);
+        for (uint32_t mask = _mm256_movemask_pd(_mm256_castsi256_pd(special)); mask != 0; mask &= mask - 1)
+            scalar_flags |= Kernel::scalar(index + count_trailing_zeros64(mask), args...);
+    }
+
+    // handle any leftovers
+    return uint16_t(reduce_or4(flags)) | scalar_flags | run_batch_scalar<Kernel>(index, count, args...);
+}
+
+#endif
+
+//
+// select the best loop for the host
+//
+template<typename Kernel, typename... Args>
+inline uint16_t run_batch(size_t count, Args... args)
+{
+#if X87_SIMD_X64
+    if (host_has_avx2())
+        return run_batch_avx2<Kernel>(count, args...);
+#endif
+    return run_batch_scalar<Kernel>(0, count, args...);
+}
+
+}
+
+#endif